@@ -7,6 +7,17 @@
 
 # cmake-format: off
 
+# benchmark
+set (BENCHMARK_VERSION 1.9.4 CACHE STRING "" FORCE)
+CPMDeclarePackage (benchmark
+                   NAME benchmark
+                   VERSION ${BENCHMARK_VERSION}
+                   GITHUB_REPOSITORY google/benchmark
+                   SYSTEM TRUE
+                   EXCLUDE_FROM_ALL TRUE
+                   OPTIONS "BENCHMARK_ENABLE_TESTING OFF" "BENCHMARK_ENABLE_WERROR OFF" "CMAKE_MESSAGE_LOG_LEVEL WARNING"
+)
+
 # googletest
 set (GOOGLETEST_VERSION 1.17.0 CACHE STRING "" FORCE)
 CPMDeclarePackage (googletest
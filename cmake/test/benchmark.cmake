@@ -0,0 +1,26 @@
+# SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+# SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+# SPDX-License-Identifier: CC0-1.0
+
+CPMGetPackage (benchmark)
+
+# Add the benchmark interface library.
+if (NOT TARGET shopping_cart_queue_benchmark)
+    add_library (shopping_cart_queue_benchmark INTERFACE)
+    target_link_libraries (shopping_cart_queue_benchmark INTERFACE benchmark::benchmark_main shopping_cart_queue_lib)
+    add_library (shopping_cart_queue::benchmark ALIAS shopping_cart_queue_benchmark)
+endif ()
+
+# Add the benchmark target that builds all benchmarks.
+add_custom_target (benchmarks)
+
+macro (add_app_benchmark benchmark_filename)
+    get_filename_component (target "${benchmark_filename}" NAME_WE)
+
+    add_executable (${target} ${benchmark_filename})
+    target_link_libraries (${target} shopping_cart_queue::benchmark)
+
+    add_dependencies (benchmarks ${target})
+
+    unset (target)
+endmacro ()
@@ -0,0 +1,258 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#pragma once
+
+#include <atomic>          // for atomic, memory_order
+#include <bit>             // for bit_ceil
+#include <cassert>         // for assert
+#include <cstddef>         // for size_t, ptrdiff_t
+#include <cstdint>         // for uint32_t, uint64_t
+#include <limits>          // for numeric_limits
+#include <memory_resource> // for memory_resource, get_default_resource
+#include <new>             // for hardware_destructive_interference_size
+#include <optional>        // for optional, nullopt
+#include <ranges>          // for input_range
+#include <vector>          // for pmr::vector
+
+// The lock-free containers of cart ids that the queues keep their empty and full carts in. Both have room for all
+// carts, i.e. a push never fails and never waits.
+//
+// Both access the ids with seq_cst where a waiter checks them: a thread that registers as waiter (seq_cst) before it
+// checks the container either sees the pushed id or the pushing thread sees the waiter when it checks for waiters
+// (seq_cst) after the push.
+namespace scq::detail
+{
+
+// A stack of cart ids (Treiber). The top is tagged with a counter that is incremented by each push and pop, such that
+// a pop that read an outdated successor fails (ABA).
+//
+// The ids can be split into several pools, e.g. one per NUMA node; each pool is a stack of its own, but the pools share
+// the successors since an id is in at most one pool at a time. A pop takes from the preferred pool first and from the
+// other pools in turn if it is empty.
+struct cart_id_stack
+{
+    static constexpr uint32_t no_id{std::numeric_limits<uint32_t>::max()};
+
+    cart_id_stack() = default;
+    explicit cart_id_stack(size_t cart_count,
+                           size_t pool_count = 1u,
+                           std::pmr::memory_resource * resource = std::pmr::get_default_resource()) :
+        tops(pool_count, resource),
+        next_ids(cart_count, resource)
+    {}
+
+    size_t pool_count() const
+    {
+        return tops.size();
+    }
+
+    // Whether all pools are empty.
+    bool empty() const
+    {
+        for (pool_top_t const & pool_top : tops)
+        {
+            if (top_id(pool_top.top.load(std::memory_order_seq_cst)) != no_id)
+                return false;
+        }
+
+        return true;
+    }
+
+    void push(size_t cart_id, size_t pool = 0u)
+    {
+        assert(cart_id < next_ids.size());
+
+        uint32_t const id = static_cast<uint32_t>(cart_id);
+        link(pool, id, id);
+    }
+
+    // Pushes all cart ids of the range with a single compare-exchange. Returns the number of pushed ids.
+    template <std::ranges::input_range range_t>
+    size_t push_range(range_t && cart_ids, size_t pool = 0u)
+    {
+        uint32_t first{no_id};
+        uint32_t last{no_id};
+        size_t pushed_count{};
+
+        for (size_t cart_id : cart_ids)
+        {
+            assert(cart_id < next_ids.size());
+
+            uint32_t const id = static_cast<uint32_t>(cart_id);
+            next_ids[id].store(first, std::memory_order_relaxed);
+            first = id;
+            ++pushed_count;
+
+            if (last == no_id)
+                last = id;
+        }
+
+        if (first != no_id)
+            link(pool, first, last);
+
+        return pushed_count;
+    }
+
+    std::optional<size_t> pop(size_t preferred_pool = 0u)
+    {
+        for (size_t i = 0u; i < tops.size(); ++i)
+        {
+            if (std::optional<size_t> cart_id = pop_from((preferred_pool + i) % tops.size()); cart_id.has_value())
+                return cart_id;
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<size_t> pop_from(size_t pool)
+    {
+        std::atomic<uint64_t> & top = tops[pool].top;
+        uint64_t old_top = top.load(std::memory_order_seq_cst);
+
+        while (top_id(old_top) != no_id)
+        {
+            // might read the successor of a cart that was popped concurrently, the tag lets the exchange fail then
+            uint32_t const next_id = next_ids[top_id(old_top)].load(std::memory_order_relaxed);
+
+            if (top.compare_exchange_weak(old_top, make_top(old_top, next_id), std::memory_order_acquire))
+                return top_id(old_top);
+        }
+
+        return std::nullopt;
+    }
+
+    // Puts the chain first -> ... -> last on top of the pool.
+    void link(size_t pool, uint32_t first, uint32_t last)
+    {
+        std::atomic<uint64_t> & top = tops[pool].top;
+        uint64_t old_top = top.load(std::memory_order_relaxed);
+
+        do
+        {
+            next_ids[last].store(top_id(old_top), std::memory_order_relaxed);
+        }
+        while (!top.compare_exchange_weak(old_top, make_top(old_top, first), std::memory_order_seq_cst));
+    }
+
+    static uint32_t top_id(uint64_t top)
+    {
+        return static_cast<uint32_t>(top);
+    }
+
+    static uint64_t make_top(uint64_t old_top, uint32_t id)
+    {
+        return ((old_top >> 32) + 1u) << 32 | id;
+    }
+
+    // The tops of different pools are pushed and popped by threads of different nodes.
+    struct alignas(std::hardware_destructive_interference_size) pool_top_t
+    {
+        std::atomic<uint64_t> top{no_id}; // tag << 32 | cart id
+    };
+
+    std::pmr::vector<pool_top_t> tops{};                // position is pool
+    std::pmr::vector<std::atomic<uint32_t>> next_ids{}; // position is cart id
+};
+
+// A bounded multi-producer multi-consumer queue of cart ids (Vyukov): the cell at position pos can be written if its
+// sequence is pos and read if its sequence is pos + 1. A default constructed ring and a ring of no carts are
+// disabled, i.e. pop never returns an id.
+struct cart_id_ring
+{
+    cart_id_ring() = default;
+    explicit cart_id_ring(size_t cart_count,
+                          std::pmr::memory_resource * resource = std::pmr::get_default_resource()) :
+        cells(cart_count == 0u ? 0u : std::bit_ceil(cart_count), resource),
+        mask{cells.empty() ? 0u : cells.size() - 1u}
+    {
+        for (size_t position = 0u; position < cells.size(); ++position)
+            cells[position].sequence.store(position, std::memory_order_relaxed);
+    }
+
+    bool enabled() const
+    {
+        return !cells.empty();
+    }
+
+    // Whether the next cell to read was not written yet.
+    bool empty() const
+    {
+        size_t const position = dequeue_position.load(std::memory_order_relaxed);
+        return cells[position & mask].sequence.load(std::memory_order_acquire) != position + 1u;
+    }
+
+    void push(size_t cart_id)
+    {
+        size_t position = enqueue_position.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            cell_t & cell = cells[position & mask];
+            size_t const sequence = cell.sequence.load(std::memory_order_acquire);
+
+            if (sequence == position)
+            {
+                if (enqueue_position.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed))
+                {
+                    cell.cart_id = cart_id;
+                    cell.sequence.store(position + 1u, std::memory_order_seq_cst);
+                    return;
+                }
+            }
+            else
+            {
+                // another producer took the position
+                position = enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::optional<size_t> pop()
+    {
+        if (!enabled())
+            return std::nullopt;
+
+        size_t position = dequeue_position.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            cell_t & cell = cells[position & mask];
+            size_t const sequence = cell.sequence.load(std::memory_order_seq_cst);
+
+            if (sequence == position + 1u)
+            {
+                if (dequeue_position.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed))
+                {
+                    size_t const cart_id = cell.cart_id;
+                    cell.sequence.store(position + cells.size(), std::memory_order_release);
+                    return cart_id;
+                }
+            }
+            else if (static_cast<std::ptrdiff_t>(sequence - (position + 1u)) < 0) // the cell was not written yet
+            {
+                return std::nullopt;
+            }
+            else
+            {
+                // another consumer took the position
+                position = dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    struct cell_t
+    {
+        std::atomic<size_t> sequence{};
+        size_t cart_id{};
+    };
+
+    std::pmr::vector<cell_t> cells{};
+    size_t mask{};
+
+    alignas(std::hardware_destructive_interference_size) std::atomic<size_t> enqueue_position{0u};
+    alignas(std::hardware_destructive_interference_size) std::atomic<size_t> dequeue_position{0u};
+};
+
+} // namespace scq::detail
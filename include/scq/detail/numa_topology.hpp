@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#pragma once
+
+#include <algorithm>    // for ranges::sort, max
+#include <charconv>     // for from_chars
+#include <cstddef>      // for size_t
+#include <filesystem>   // for path, directory_iterator
+#include <fstream>      // for ifstream
+#include <string>       // for string, getline
+#include <string_view>  // for string_view
+#include <system_error> // for error_code, errc
+#include <thread>       // for thread
+#include <utility>      // for pair, move
+#include <vector>       // for vector
+
+#if defined(__linux__)
+#    include <pthread.h> // for pthread_setaffinity_np, pthread_self
+#    include <sched.h>   // for cpu_set_t, CPU_ZERO, CPU_SET, CPU_SETSIZE, sched_getcpu
+#endif
+
+// The NUMA nodes of the system as the kernel lists them in /sys/devices/system/node, i.e. without libnuma. The nodes
+// are numbered densely in the order of their kernel ids; nodes without CPUs (memory-only nodes) are left out, since no
+// producer runs on them. Systems without that directory (or other systems than Linux) have a single node.
+namespace scq::detail
+{
+
+// Parses a CPU list of the kernel, e.g. "0-3,8,10-11". Returns no CPUs if the list is malformed.
+inline std::vector<size_t> parse_cpu_list(std::string_view cpu_list)
+{
+    std::vector<size_t> cpus{};
+
+    auto parse_number = [](std::string_view text, size_t & number)
+    {
+        auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), number);
+        return error == std::errc{} && end == text.data() + text.size();
+    };
+
+    while (!cpu_list.empty() && cpu_list.back() == '\n')
+        cpu_list.remove_suffix(1u);
+
+    while (!cpu_list.empty())
+    {
+        size_t const comma = cpu_list.find(',');
+        std::string_view const range = cpu_list.substr(0u, comma);
+        cpu_list = comma == std::string_view::npos ? std::string_view{} : cpu_list.substr(comma + 1u);
+
+        size_t const dash = range.find('-');
+        size_t first{};
+        size_t last{};
+
+        if (!parse_number(range.substr(0u, dash), first)
+            || !parse_number(dash == std::string_view::npos ? range : range.substr(dash + 1u), last) || last < first)
+            return {};
+
+        for (size_t cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
+
+    return cpus;
+}
+
+struct numa_topology
+{
+    size_t node_count() const
+    {
+        return std::max<size_t>(node_cpus.size(), 1u);
+    }
+
+    // The node the calling thread currently runs on.
+    size_t current_node() const
+    {
+#if defined(__linux__)
+        if (int const cpu = sched_getcpu(); cpu >= 0 && static_cast<size_t>(cpu) < cpu_nodes.size())
+            return cpu_nodes[cpu];
+#endif
+        return 0u;
+    }
+
+    // Runs fn(node) for each node on a thread that is bound to the CPUs of that node, e.g. to first touch memory
+    // on the node. If the thread cannot be bound, fn still runs, but maybe on another node.
+    template <typename fn_t>
+    void run_on_each_node(fn_t && fn) const
+    {
+        std::vector<std::thread> node_threads{};
+
+        for (size_t node = 0u; node < node_count(); ++node)
+        {
+            node_threads.emplace_back(
+                [this, &fn, node]
+                {
+                    bind_to_node(node);
+                    fn(node);
+                });
+        }
+
+        for (std::thread & node_thread : node_threads)
+            node_thread.join();
+    }
+
+    void bind_to_node([[maybe_unused]] size_t node) const
+    {
+#if defined(__linux__)
+        if (node >= node_cpus.size())
+            return;
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+
+        for (size_t cpu : node_cpus[node])
+        {
+            if (cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &cpu_set);
+        }
+
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#endif
+    }
+
+    std::vector<std::vector<size_t>> node_cpus{}; // position is node
+    std::vector<size_t> cpu_nodes{};              // position is cpu
+};
+
+// Reads the nodes of node_directory, i.e. its subdirectories node<id> and their cpulist files.
+inline numa_topology read_numa_topology(std::filesystem::path const & node_directory = "/sys/devices/system/node")
+{
+    std::vector<std::pair<size_t, std::vector<size_t>>> nodes{}; // kernel id and CPUs
+
+    std::error_code error{};
+    for (std::filesystem::directory_iterator entry{node_directory, error}, end{}; !error && entry != end;
+         entry.increment(error))
+    {
+        std::string const name = entry->path().filename().string();
+        std::string_view const prefix{"node"};
+        size_t id{};
+
+        if (!name.starts_with(prefix))
+            continue;
+
+        if (auto [id_end, id_error] = std::from_chars(name.data() + prefix.size(), name.data() + name.size(), id);
+            id_error != std::errc{} || id_end != name.data() + name.size())
+            continue;
+
+        std::ifstream cpu_list_file{entry->path() / "cpulist"};
+        std::string cpu_list{};
+        std::getline(cpu_list_file, cpu_list);
+
+        if (std::vector<size_t> cpus = parse_cpu_list(cpu_list); !cpus.empty())
+            nodes.emplace_back(id, std::move(cpus));
+    }
+
+    std::ranges::sort(nodes);
+
+    numa_topology topology{};
+
+    for (auto & [id, cpus] : nodes)
+    {
+        size_t const node = topology.node_cpus.size();
+
+        for (size_t cpu : cpus)
+        {
+            if (cpu >= topology.cpu_nodes.size())
+                topology.cpu_nodes.resize(cpu + 1u, 0u);
+
+            topology.cpu_nodes[cpu] = node;
+        }
+
+        topology.node_cpus.push_back(std::move(cpus));
+    }
+
+    return topology;
+}
+
+// The topology of the system, read once.
+inline numa_topology const & system_numa_topology()
+{
+    static numa_topology const topology = read_numa_topology();
+    return topology;
+}
+
+} // namespace scq::detail
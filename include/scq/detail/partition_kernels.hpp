@@ -0,0 +1,320 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#pragma once
+
+#include <array>    // for array
+#include <bit>      // for popcount
+#include <concepts> // for integral
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t, uint64_t
+#include <vector>   // for vector
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#    define SCQ_X86_64_PARTITION_KERNELS 1
+#    include <immintrin.h> // for __m256i, __m512i, _mm256_*, _mm512_*
+#else
+#    define SCQ_X86_64_PARTITION_KERNELS 0
+#endif
+
+// The kernels that partition a batch of (slot, value) pairs by slot for slotted_cart_queue::enqueue_scatter. They work
+// on 8-byte integers, e.g. uint64_t hashes.
+//
+// count_slots adds the number of values of each slot to slot_counts.
+// partition_values writes the values of each slot to [slot_offsets[slot_id], slot_offsets[slot_id + 1]) of
+// partitioned_values; values of the same slot keep their relative order.
+//
+// The x86-64 kernels are compiled for their instruction set via the target attribute and are selected at runtime,
+// i.e. the library does not need to be compiled with -mavx2 / -mavx512f.
+namespace scq::detail
+{
+
+template <typename value_t>
+concept partitionable_value = std::integral<value_t> && sizeof(value_t) == sizeof(uint64_t);
+
+enum class partition_isa
+{
+    scalar,
+    avx2,
+    avx512
+};
+
+template <partitionable_value value_t>
+struct partition_kernels
+{
+    using count_slots_t = void (*)(size_t const * slot_ids, size_t count, size_t * slot_counts);
+    using partition_values_t = void (*)(size_t const * slot_ids,
+                                        value_t const * values,
+                                        size_t count,
+                                        size_t const * slot_offsets,
+                                        size_t slot_count,
+                                        value_t * partitioned_values);
+
+    partition_isa isa;
+    count_slots_t count_slots;
+    partition_values_t partition_values;
+};
+
+inline size_t touched_slot_count(size_t const * slot_offsets, size_t slot_count)
+{
+    size_t count{};
+    for (size_t slot_id = 0u; slot_id < slot_count; ++slot_id)
+        count += slot_offsets[slot_id + 1u] != slot_offsets[slot_id];
+    return count;
+}
+
+inline void count_slots_scalar(size_t const * slot_ids, size_t count, size_t * slot_counts)
+{
+    for (size_t i = 0u; i < count; ++i)
+        ++slot_counts[slot_ids[i]];
+}
+
+template <partitionable_value value_t>
+void partition_values_scalar(size_t const * slot_ids,
+                             value_t const * values,
+                             size_t count,
+                             size_t const * slot_offsets,
+                             size_t slot_count,
+                             value_t * partitioned_values)
+{
+    std::vector<size_t> next_positions(slot_offsets, slot_offsets + slot_count);
+
+    for (size_t i = 0u; i < count; ++i)
+        partitioned_values[next_positions[slot_ids[i]]++] = values[i];
+}
+
+#if SCQ_X86_64_PARTITION_KERNELS
+
+// AVX2 has neither scatter nor conflict detection, i.e. only the compress path is vectorised. A compress-store of four
+// 64-bit lanes is emulated by a permutation of the selected lanes to the front and a masked store.
+struct avx2_compress_table
+{
+    static constexpr std::array<std::array<uint32_t, 8>, 16> permutations = []
+    {
+        std::array<std::array<uint32_t, 8>, 16> table{};
+
+        for (uint32_t mask = 0u; mask < 16u; ++mask)
+        {
+            uint32_t position{};
+            for (uint32_t lane = 0u; lane < 4u; ++lane)
+            {
+                if (mask & (1u << lane))
+                {
+                    table[mask][2u * position] = 2u * lane;
+                    table[mask][2u * position + 1u] = 2u * lane + 1u;
+                    ++position;
+                }
+            }
+        }
+
+        return table;
+    }();
+};
+
+template <partitionable_value value_t>
+__attribute__((target("avx2"))) void partition_values_avx2(size_t const * slot_ids,
+                                                           value_t const * values,
+                                                           size_t count,
+                                                           size_t const * slot_offsets,
+                                                           size_t slot_count,
+                                                           value_t * partitioned_values)
+{
+    // If a batch touches at most this many slots, the values of each touched slot are extracted with compress-stores
+    // in one pass over the batch per slot instead of scattering each value to its slot (see enqueue_scatter_benchmark).
+    static constexpr size_t max_compress_slot_count{2u};
+
+    if (touched_slot_count(slot_offsets, slot_count) > max_compress_slot_count)
+    {
+        partition_values_scalar(slot_ids, values, count, slot_offsets, slot_count, partitioned_values);
+        return;
+    }
+
+    __m256i const lane_ids = _mm256_set_epi64x(3, 2, 1, 0);
+
+    for (size_t slot_id = 0u; slot_id < slot_count; ++slot_id)
+    {
+        if (slot_offsets[slot_id + 1u] == slot_offsets[slot_id])
+            continue;
+
+        __m256i const slot_id_vector = _mm256_set1_epi64x(static_cast<long long>(slot_id));
+        value_t * output = partitioned_values + slot_offsets[slot_id];
+
+        size_t i = 0u;
+        for (; i + 4u <= count; i += 4u)
+        {
+            __m256i const ids = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(slot_ids + i));
+            __m256i const value_vector = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(values + i));
+
+            uint32_t const mask = static_cast<uint32_t>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(ids, slot_id_vector))));
+            int const selected_count = std::popcount(mask);
+
+            __m256i const permutation = _mm256_loadu_si256(
+                reinterpret_cast<__m256i const *>(avx2_compress_table::permutations[mask].data()));
+            __m256i const store_mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(selected_count), lane_ids);
+
+            _mm256_maskstore_epi64(reinterpret_cast<long long *>(output),
+                                   store_mask,
+                                   _mm256_permutevar8x32_epi32(value_vector, permutation));
+            output += selected_count;
+        }
+
+        for (; i < count; ++i)
+            if (slot_ids[i] == slot_id)
+                *output++ = values[i];
+    }
+}
+
+// Gathers base[ids[lane]] for all eight lanes.
+__attribute__((target("avx512f"))) inline __m512i gather_epi64(__m512i ids, size_t const * base)
+{
+    // the unmasked gather leaves its source register undefined, which GCC reports as maybe-uninitialized
+    return _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), __mmask8{0xFF}, ids, base, sizeof(size_t));
+}
+
+// Eight values at once: The slot counts / positions are gathered, incremented and scattered back. This is only valid
+// if the eight slot ids are distinct, which the conflict detection (AVX-512CD) checks; otherwise, the eight values are
+// processed one by one.
+__attribute__((target("avx512f,avx512cd"))) inline void
+count_slots_avx512(size_t const * slot_ids, size_t count, size_t * slot_counts)
+{
+    __m512i const one = _mm512_set1_epi64(1);
+
+    size_t i = 0u;
+    for (; i + 8u <= count; i += 8u)
+    {
+        __m512i const ids = _mm512_loadu_si512(slot_ids + i);
+        __m512i const conflicts = _mm512_conflict_epi64(ids);
+
+        if (_mm512_test_epi64_mask(conflicts, conflicts) == 0u)
+        {
+            __m512i const counts = gather_epi64(ids, slot_counts);
+            _mm512_i64scatter_epi64(slot_counts, ids, _mm512_add_epi64(counts, one), sizeof(size_t));
+        }
+        else
+        {
+            count_slots_scalar(slot_ids + i, 8u, slot_counts);
+        }
+    }
+
+    count_slots_scalar(slot_ids + i, count - i, slot_counts);
+}
+
+template <partitionable_value value_t>
+__attribute__((target("avx512f,avx512cd"))) void partition_values_avx512(size_t const * slot_ids,
+                                                                         value_t const * values,
+                                                                         size_t count,
+                                                                         size_t const * slot_offsets,
+                                                                         size_t slot_count,
+                                                                         value_t * partitioned_values)
+{
+    // few slots: one pass with compress-stores per slot (see enqueue_scatter_benchmark)
+    static constexpr size_t max_compress_slot_count{4u};
+
+    if (touched_slot_count(slot_offsets, slot_count) <= max_compress_slot_count)
+    {
+        for (size_t slot_id = 0u; slot_id < slot_count; ++slot_id)
+        {
+            if (slot_offsets[slot_id + 1u] == slot_offsets[slot_id])
+                continue;
+
+            __m512i const slot_id_vector = _mm512_set1_epi64(static_cast<long long>(slot_id));
+            value_t * output = partitioned_values + slot_offsets[slot_id];
+
+            size_t i = 0u;
+            for (; i + 8u <= count; i += 8u)
+            {
+                __mmask8 const mask = _mm512_cmpeq_epi64_mask(_mm512_loadu_si512(slot_ids + i), slot_id_vector);
+                _mm512_mask_compressstoreu_epi64(output, mask, _mm512_loadu_si512(values + i));
+                output += std::popcount(static_cast<uint32_t>(mask));
+            }
+
+            for (; i < count; ++i)
+                if (slot_ids[i] == slot_id)
+                    *output++ = values[i];
+        }
+
+        return;
+    }
+
+    // many slots: scatter each value to the next position of its slot
+    std::vector<size_t> next_positions(slot_offsets, slot_offsets + slot_count);
+    __m512i const one = _mm512_set1_epi64(1);
+
+    size_t i = 0u;
+    for (; i + 8u <= count; i += 8u)
+    {
+        __m512i const ids = _mm512_loadu_si512(slot_ids + i);
+        __m512i const conflicts = _mm512_conflict_epi64(ids);
+
+        if (_mm512_test_epi64_mask(conflicts, conflicts) == 0u)
+        {
+            __m512i const positions = gather_epi64(ids, next_positions.data());
+            _mm512_i64scatter_epi64(partitioned_values, positions, _mm512_loadu_si512(values + i), sizeof(value_t));
+            _mm512_i64scatter_epi64(next_positions.data(), ids, _mm512_add_epi64(positions, one), sizeof(size_t));
+        }
+        else
+        {
+            for (size_t j = i; j < i + 8u; ++j)
+                partitioned_values[next_positions[slot_ids[j]]++] = values[j];
+        }
+    }
+
+    for (; i < count; ++i)
+        partitioned_values[next_positions[slot_ids[i]]++] = values[i];
+}
+
+#endif // SCQ_X86_64_PARTITION_KERNELS
+
+inline bool is_supported(partition_isa isa)
+{
+#if SCQ_X86_64_PARTITION_KERNELS
+    __builtin_cpu_init();
+
+    switch (isa)
+    {
+    case partition_isa::avx512:
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd");
+    case partition_isa::avx2:
+        return __builtin_cpu_supports("avx2");
+    default:
+        return true;
+    }
+#else
+    return isa == partition_isa::scalar;
+#endif
+}
+
+// Expects is_supported(isa).
+template <partitionable_value value_t>
+partition_kernels<value_t> get_partition_kernels(partition_isa isa)
+{
+#if SCQ_X86_64_PARTITION_KERNELS
+    if (isa == partition_isa::avx512)
+        return {partition_isa::avx512, count_slots_avx512, partition_values_avx512<value_t>};
+
+    if (isa == partition_isa::avx2)
+        return {partition_isa::avx2, count_slots_scalar, partition_values_avx2<value_t>};
+#endif
+
+    return {partition_isa::scalar, count_slots_scalar, partition_values_scalar<value_t>};
+}
+
+// The kernels of the best instruction set the CPU supports; determined once.
+template <partitionable_value value_t>
+partition_kernels<value_t> const & select_partition_kernels()
+{
+    static partition_kernels<value_t> const kernels = []
+    {
+        for (partition_isa isa : {partition_isa::avx512, partition_isa::avx2})
+            if (is_supported(isa))
+                return get_partition_kernels<value_t>(isa);
+
+        return get_partition_kernels<value_t>(partition_isa::scalar);
+    }();
+
+    return kernels;
+}
+
+} // namespace scq::detail
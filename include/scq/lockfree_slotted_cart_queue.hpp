@@ -0,0 +1,477 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#pragma once
+
+#include <algorithm>       // for min, max
+#include <atomic>          // for atomic, atomic_bool
+#include <cassert>         // for assert
+#include <cstddef>         // for size_t, byte
+#include <cstdint>         // for uint32_t, uint64_t
+#include <memory>          // for construct_at
+#include <memory_resource> // for memory_resource, polymorphic_allocator, get_default_resource
+#include <new>             // for hardware_destructive_interference_size
+#include <optional>        // for optional, nullopt
+#include <span>            // for span
+#include <stdexcept>       // for logic_error, overflow_error
+#include <type_traits>     // for is_trivially_copyable_v
+#include <utility>         // for pair
+#include <vector>          // for pmr::vector
+
+#include <scq/detail/lock_free_cart_ids.hpp> // for cart_id_stack, cart_id_ring
+#include <scq/slotted_cart_queue.hpp>        // for params, slot_id, cart_future, wait_strategy, spin_until, map_hug...
+
+namespace scq
+{
+
+// A slotted cart queue for trivially copyable elements that takes no locks: producers reserve positions in the cart of
+// their slot with a fetch-add, the empty carts are kept in a lock-free stack and the full carts in a lock-free ring
+// buffer. A thread only blocks (on a futex, via std::atomic::wait) if no cart is available after spinning according
+// to params::wait_strategy.
+//
+// enqueue, dequeue, close and the returned cart_future behave like those of slotted_cart_queue. The full carts are
+// handed out in the order they were filled, i.e. like cart_order::fifo; params::cart_order, lock_stripes,
+// simd_scatter, lock_free_full_carts and numa_aware do not apply, partitions and exclusive_slots are not supported.
+template <typename value_t>
+class lockfree_slotted_cart_queue
+{
+    static_assert(std::is_trivially_copyable_v<value_t>,
+                  "The value_type of a lockfree_slotted_cart_queue must be trivially copyable.");
+
+public:
+    using value_type = value_t;
+    using cart_future_type = cart_future<value_type, lockfree_slotted_cart_queue>;
+
+    lockfree_slotted_cart_queue() = default;
+    lockfree_slotted_cart_queue(lockfree_slotted_cart_queue const &) = delete;
+    lockfree_slotted_cart_queue(lockfree_slotted_cart_queue &&) = delete;
+    lockfree_slotted_cart_queue & operator=(lockfree_slotted_cart_queue const &) = delete;
+    lockfree_slotted_cart_queue & operator=(lockfree_slotted_cart_queue &&) = delete;
+
+    lockfree_slotted_cart_queue(params params) :
+        slot_count{params.slots},
+        cart_count{params.carts},
+        cart_capacity{params.capacity},
+        cart_stride{(params.capacity * sizeof(value_type) + cart_alignment - 1u) / cart_alignment * cart_alignment},
+        wait_strategy{params.wait_strategy},
+        allocator{params.memory_resource != nullptr ? params.memory_resource : std::pmr::get_default_resource()},
+        internal_cart_slots(params.slots, allocator),
+        cart_fill_states(params.carts, allocator),
+        empty_carts{params.carts, 1u, allocator.resource()},
+        full_carts{params.carts, allocator.resource()}
+    {
+        if (cart_count < slot_count)
+            throw std::logic_error{"The number of carts must be >= the number of slots."};
+
+        if (cart_capacity == 0u)
+            throw std::logic_error{"The cart capacity must be >= 1."};
+
+        if (cart_count > max_cart_count)
+            throw std::logic_error{"The number of carts must be < 2^32 - 2."};
+
+        if (cart_capacity > max_cart_capacity)
+            throw std::logic_error{"The cart capacity must be <= 2^31."};
+
+        if (params.partitions != 1u || params.exclusive_slots)
+            throw std::logic_error{"lockfree_slotted_cart_queue supports neither partitions nor exclusive slots."};
+
+        if (params.huge_pages)
+            mapping = detail::map_huge_pages(cart_count * cart_stride);
+
+        void * memory =
+            mapping.data != nullptr ? mapping.data : allocator.allocate_bytes(cart_count * cart_stride, cart_alignment);
+        internal_queue_memory = static_cast<std::byte *>(memory);
+
+        for (size_t cart_id = 0u; cart_id < cart_count; ++cart_id)
+            empty_carts.push(cart_id);
+    }
+
+    ~lockfree_slotted_cart_queue()
+    {
+        if (mapping.data != nullptr)
+            detail::unmap_huge_pages(mapping);
+        else if (internal_queue_memory != nullptr)
+            allocator.deallocate_bytes(internal_queue_memory, cart_count * cart_stride, cart_alignment);
+    }
+
+    void enqueue(slot_id slot, value_type value)
+    {
+        if (!enqueue_in_slot_cart(slot, value))
+            throw std::overflow_error{"lockfree_slotted_cart_queue is already closed."};
+    }
+
+    // Blocks until a full cart is available. Returns an invalid cart_future once the queue was closed and all carts
+    // were dequeued.
+    cart_future_type dequeue()
+    {
+        std::optional<size_t> cart_id{};
+
+        bool const blocked = wait_until(full_cart_event,
+                                        [this, &cart_id]
+                                        {
+                                            // No further carts are published after the full carts were closed. The
+                                            // flag is read before the ring: the last cart might be published right
+                                            // before the full carts are closed, i.e. after a pop that found no cart.
+                                            bool const was_closed = full_carts_closed;
+                                            return (cart_id = full_carts.pop()).has_value() || was_closed;
+                                        });
+
+        cart_future_type cart_future{};
+
+        if (cart_id.has_value())
+        {
+            // each cart woke up a single consumer, which might not have been the one that took it
+            if (blocked && !full_carts.empty())
+                full_cart_event.notify_one();
+
+            cart_fill_state_t const & cart_fill_state = cart_fill_states[*cart_id];
+            cart_future.id = cart_fill_state.slot;
+            cart_future.memory_region = memory_region(*cart_id).first(cart_fill_state.size);
+            cart_future.cart_queue = this;
+        }
+
+        return cart_future;
+    }
+
+    void close()
+    {
+        // producers check this flag before they wait, i.e. after this point no producer blocks anymore
+        queue_closed = true;
+
+        // seal all non-empty / non-full carts; a sealed cart is published by its last committing producer
+        for (size_t slot_id = 0u; slot_id < slot_count; ++slot_id)
+            seal(slot_id);
+
+        // release producers that wait for an empty cart or for the cart of their slot
+        empty_cart_event.notify_all();
+        slot_cart_event.notify_all();
+
+        // producers that reserved a position before the carts were sealed might still write their elements
+        for (size_t count = active_cart_count.load(); count != 0u; count = active_cart_count.load())
+            active_cart_count.wait(count);
+
+        // release consumers only after all pending carts were handed over
+        full_carts_closed = true;
+        full_cart_event.notify_all();
+    }
+
+    // The pages that back the cart memory, see params::huge_pages.
+    scq::cart_memory_pages cart_memory_pages() const
+    {
+        return mapping.pages;
+    }
+
+private:
+    friend cart_future_type;
+
+    using slot_state_t = uint64_t;
+
+    // The state of a slot is its current cart and the number of reserved positions; instead of a cart, it might hold
+    // a marker: no_cart (no producer requested a cart yet), requested_cart (a producer fetches an empty cart for the
+    // slot) or sealed_cart (the queue was closed).
+    static constexpr size_t position_bits{32u};
+    static constexpr slot_state_t position_mask{(slot_state_t{1u} << position_bits) - 1u};
+    static constexpr size_t no_cart{position_mask};
+    static constexpr size_t requested_cart{no_cart - 1u};
+    static constexpr size_t sealed_cart{no_cart - 2u};
+
+    static constexpr size_t max_cart_count{sealed_cart};
+    // Each cart starts on a cache line of its own, such that the producers of neighbouring carts do not interfere.
+    static constexpr size_t cart_alignment{std::max(std::hardware_destructive_interference_size, alignof(value_type))};
+    // Producers might reserve beyond the capacity of a cart before a new cart is set; the remaining bits absorb this.
+    static constexpr size_t max_cart_capacity{size_t{1u} << (position_bits - 1u)};
+    // A producer checks the position before it reserves a single position, i.e. each thread overshoots at most once
+    // per cart, and there are fewer threads than Linux' PID_MAX_LIMIT (2^22).
+    static_assert(max_cart_capacity - 1u + (size_t{1u} << 22) <= position_mask,
+                  "The overshooting reservations must not overflow into the cart id.");
+
+    // Each slot resides on its own cache line, such that the producers of different slots do not interfere.
+    struct alignas(std::hardware_destructive_interference_size) internal_slot_t
+    {
+        std::atomic<slot_state_t> state{make_state(no_cart, 0u)};
+    };
+
+    // Each fill state resides on its own cache line, such that the producers of different carts do not interfere.
+    struct alignas(std::hardware_destructive_interference_size) cart_fill_state_t
+    {
+        std::atomic<size_t> committed_count{0u}; // the cart is complete if committed_count reaches cart_capacity
+        size_t size{0u};                          // cart_capacity unless the cart was sealed
+        scq::slot_id slot{};
+    };
+
+    // Threads wait on the epoch, which is incremented by each event. The events only cost an atomic increment and load
+    // unless threads wait.
+    struct alignas(std::hardware_destructive_interference_size) event_t
+    {
+        void notify_one()
+        {
+            epoch.fetch_add(1u, std::memory_order_seq_cst);
+
+            if (waiter_count.load(std::memory_order_seq_cst) > 0u)
+                epoch.notify_one();
+        }
+
+        void notify_all()
+        {
+            epoch.fetch_add(1u, std::memory_order_seq_cst);
+
+            if (waiter_count.load(std::memory_order_seq_cst) > 0u)
+                epoch.notify_all();
+        }
+
+        std::atomic<uint32_t> epoch{0u};
+        std::atomic<uint32_t> waiter_count{0u};
+    };
+
+    struct wait_indefinitely
+    {
+        bool expired() const
+        {
+            return false;
+        }
+    };
+
+    static slot_state_t make_state(size_t cart_id, size_t position)
+    {
+        return (slot_state_t{cart_id} << position_bits) | position;
+    }
+
+    static size_t cart_of(slot_state_t state)
+    {
+        return state >> position_bits;
+    }
+
+    static size_t position_of(slot_state_t state)
+    {
+        return state & position_mask;
+    }
+
+    bool has_free_positions(slot_state_t state) const
+    {
+        return cart_of(state) < cart_count && position_of(state) < cart_capacity;
+    }
+
+    std::span<value_type> memory_region(size_t cart_id)
+    {
+        return {reinterpret_cast<value_type *>(internal_queue_memory + cart_id * cart_stride), cart_capacity};
+    }
+
+    // Spins according to the wait strategy until ready() holds, afterwards blocks on the event. ready() must check
+    // the state the event is notified for with seq_cst: the waiter registers before it checks ready(), i.e. either
+    // the notifying thread sees the waiter or the waiter sees the new state.
+    // Returns whether the thread blocked.
+    template <typename ready_t>
+    bool wait_until(event_t & event, ready_t && ready)
+    {
+        if (ready() || detail::spin_until(wait_strategy, wait_indefinitely{}, ready))
+            return false;
+
+        event.waiter_count.fetch_add(1u, std::memory_order_seq_cst);
+
+        for (uint32_t epoch = event.epoch.load(std::memory_order_seq_cst); !ready();
+             epoch = event.epoch.load(std::memory_order_seq_cst))
+            event.epoch.wait(epoch, std::memory_order_seq_cst);
+
+        event.waiter_count.fetch_sub(1u, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Returns false if the queue was closed.
+    bool enqueue_in_slot_cart(slot_id slot, value_type const & value)
+    {
+        assert(slot.value < slot_count);
+
+        std::atomic<slot_state_t> & state = internal_cart_slots[slot.value].state;
+
+        while (true)
+        {
+            slot_state_t current_state = state.load(std::memory_order_acquire);
+
+            if (has_free_positions(current_state))
+            {
+                // acquire: the cart was set by set_cart
+                current_state = state.fetch_add(1u, std::memory_order_acq_rel);
+
+                if (has_free_positions(current_state))
+                {
+                    size_t const cart_id = cart_of(current_state);
+                    std::construct_at(memory_region(cart_id).data() + position_of(current_state), value);
+                    commit(cart_id, 1u);
+                    return true;
+                }
+
+                continue; // the cart became full in the meantime
+            }
+
+            switch (cart_of(current_state))
+            {
+            case sealed_cart:
+                return false;
+            case requested_cart:
+                if (queue_closed) // the requesting producer gave up, the slot is about to be sealed
+                    return false;
+
+                // another producer fetches an empty cart for the slot
+                wait_until(slot_cart_event,
+                           [this, &state]
+                           {
+                               return queue_closed || cart_of(state.load(std::memory_order_seq_cst)) != requested_cart;
+                           });
+                break;
+            default: // no cart or the cart is completely reserved; only one producer per slot fetches an empty cart
+                if (state.compare_exchange_strong(current_state,
+                                                  make_state(requested_cart, 0u),
+                                                  std::memory_order_acq_rel)
+                    && !set_cart(slot))
+                    return false;
+            }
+        }
+    }
+
+    // Fetches an empty cart and sets it for the slot. Expects the slot to be in the requested state.
+    // Returns false if the queue was closed.
+    bool set_cart(slot_id slot)
+    {
+        std::optional<size_t> cart_id{};
+
+        bool const blocked = wait_until(empty_cart_event,
+                                        [this, &cart_id]
+                                        {
+                                            return queue_closed || (cart_id = pop_empty_cart()).has_value();
+                                        });
+
+        if (!cart_id.has_value())
+            return false;
+
+        // each cart woke up a single producer, which might not have been the one that took it
+        if (blocked && !empty_carts.empty())
+            empty_cart_event.notify_one();
+
+        cart_fill_state_t & cart_fill_state = cart_fill_states[*cart_id];
+        cart_fill_state.committed_count.store(0u, std::memory_order_relaxed);
+        cart_fill_state.size = cart_capacity;
+        cart_fill_state.slot = slot;
+
+        // producers that reserve in the requested state only change its position; close might have sealed the slot
+        std::atomic<slot_state_t> & state = internal_cart_slots[slot.value].state;
+        slot_state_t current_state = state.load(std::memory_order_relaxed);
+
+        while (cart_of(current_state) == requested_cart)
+        {
+            // release: producers that reserve a position in the new cart see the reset cart_fill_state
+            if (state.compare_exchange_weak(current_state, make_state(*cart_id, 0u), std::memory_order_seq_cst))
+            {
+                slot_cart_event.notify_all();
+                return true;
+            }
+        }
+
+        push_empty_cart(*cart_id);
+        notify_cart_published();
+        return false;
+    }
+
+    // Marks count positions of the cart as committed and publishes the cart if it is complete.
+    void commit(size_t cart_id, size_t count)
+    {
+        // acq_rel: the publisher needs to see the elements of all producers that committed to this cart
+        size_t const committed_count =
+            cart_fill_states[cart_id].committed_count.fetch_add(count, std::memory_order_acq_rel);
+
+        if (committed_count + count == cart_capacity)
+            publish(cart_id);
+    }
+
+    // Detaches the cart from the slot, such that no further positions can be reserved, and marks the unreserved
+    // positions as committed. Expects the queue to be closed.
+    void seal(size_t slot_id)
+    {
+        slot_state_t const state =
+            internal_cart_slots[slot_id].state.exchange(make_state(sealed_cart, 0u), std::memory_order_acq_rel);
+
+        size_t const cart_id = cart_of(state);
+        size_t const reserved_count = std::min<size_t>(position_of(state), cart_capacity);
+
+        // a completely reserved cart is published by the producer that commits last
+        if (cart_id >= cart_count || reserved_count == cart_capacity)
+            return;
+
+        cart_fill_states[cart_id].size = reserved_count;
+        commit(cart_id, cart_capacity - reserved_count);
+    }
+
+    void publish(size_t cart_id)
+    {
+        if (cart_fill_states[cart_id].size > 0u)
+        {
+            full_carts.push(cart_id);
+            full_cart_event.notify_one();
+        }
+        else // a sealed cart without elements
+        {
+            push_empty_cart(cart_id);
+        }
+
+        notify_cart_published();
+    }
+
+    std::optional<size_t> pop_empty_cart()
+    {
+        std::optional<size_t> cart_id = empty_carts.pop();
+
+        if (cart_id.has_value())
+            active_cart_count.fetch_add(1u);
+
+        return cart_id;
+    }
+
+    void push_empty_cart(size_t cart_id)
+    {
+        empty_carts.push(cart_id);
+        empty_cart_event.notify_one();
+    }
+
+    void notify_cart_published()
+    {
+        if (active_cart_count.fetch_sub(1u) == 1u && queue_closed)
+            active_cart_count.notify_all();
+    }
+
+    void notify_processed_cart(cart_future_type & cart_future)
+    {
+        std::byte * const cart_memory = reinterpret_cast<std::byte *>(cart_future.memory_region.data());
+        size_t const cart_id = static_cast<size_t>(cart_memory - internal_queue_memory) / cart_stride;
+
+        push_empty_cart(cart_id);
+    }
+
+    size_t slot_count{};
+    size_t cart_count{};
+    size_t cart_capacity{};
+    size_t cart_stride{}; // the bytes from one cart to the next
+    scq::wait_strategy wait_strategy{};
+    std::pmr::polymorphic_allocator<value_type> allocator{}; // all storage is allocated from params::memory_resource
+
+    std::pmr::vector<internal_slot_t> internal_cart_slots{}; // position is slot_id
+    std::pmr::vector<cart_fill_state_t> cart_fill_states{};  // position is cart id
+
+    detail::cart_id_stack empty_carts{};
+    detail::cart_id_ring full_carts{};
+
+    detail::huge_page_mapping mapping{};        // params::huge_pages: the mapping that holds the cart memory
+    std::byte * internal_queue_memory{nullptr}; // cart i starts at byte i * cart_stride
+
+    // number of carts that were taken from the empty carts but not yet published (or returned)
+    alignas(std::hardware_destructive_interference_size) std::atomic<size_t> active_cart_count{0u};
+
+    // read by each enqueue and dequeue, apart from the counter above
+    alignas(std::hardware_destructive_interference_size) std::atomic_bool queue_closed{false};
+    std::atomic_bool full_carts_closed{false};
+
+    event_t empty_cart_event{}; // an empty cart was returned
+    event_t slot_cart_event{};  // a cart was set for some slot
+    event_t full_cart_event{};  // a cart was published
+};
+
+} // namespace scq
@@ -6,8 +6,10 @@
 
 // IWYU pragma: begin_exports
 #include <atomic>             // for atomic, atomic_bool
+#include <chrono>             // for time_point, duration, steady_clock
 #include <cassert>            // for assert
 #include <condition_variable> // for condition_variable
+#include <coroutine>          // for coroutine_handle
 #include <future>             // for future_errc, future_error
 #include <mutex>              // for mutex, unique_lock, scoped_lock
 #include <optional>           // for optional
@@ -15,19 +17,106 @@
 #include <stdexcept>          // for runtime_error, logic_error, overflow_error
 // IWYU pragma: end_exports
 
-#include <cstddef> // for size_t, ptrdiff_t
-#include <string>  // for char_traits, operator+, basic_string, to_string, string
-#include <utility> // for pair
-#include <vector>  // for allocator, move, vector
+#include <algorithm>       // for min, max, all_of, any_of, transform
+#include <concepts>        // for constructible_from, invocable
+#include <cstddef>         // for size_t, ptrdiff_t, byte
+#include <cstdint>         // for uint32_t, uint64_t, uintptr_t
+#include <cstring>         // for memcpy
+#include <exception>       // for exception_ptr, current_exception, rethrow_exception
+#include <fstream>         // for ifstream
+#include <iterator>        // for iter_reference_t
+#include <limits>          // for numeric_limits
+#include <memory>          // for addressof, construct_at, ranges::destroy, ranges::uninitialized_default_construct, ...
+#include <memory_resource> // for memory_resource, polymorphic_allocator, get_default_resource
+#include <new>             // for hardware_destructive_interference_size, bad_alloc
+#include <numeric>         // for inclusive_scan
+#include <ranges>          // for input_range, forward_range, range_reference_t, begin, end, distance, views::transfo...
+#include <semaphore>       // for binary_semaphore
+#include <string>          // for char_traits, operator+, basic_string, to_string, string, getline
+#include <system_error>    // for system_error, generic_category
+#include <thread>          // for thread, this_thread::yield
+#include <type_traits>     // for is_nothrow_constructible_v, is_nothrow_move_constructible_v, is_nothrow_default_con...
+#include <utility>         // for pair, declval, exchange
+#include <vector>          // for vector, pmr::vector
+
+#if defined(__x86_64__) || defined(__i386__)
+#    include <immintrin.h> // for _mm_pause
+#endif
+
+#if defined(__linux__)
+#    include <pthread.h>  // for pthread_setaffinity_np
+#    include <sched.h>    // for cpu_set_t, CPU_ZERO, CPU_SET, CPU_SETSIZE
+#    include <sys/mman.h> // for mmap, munmap, madvise, MAP_HUGETLB, MAP_HUGE_SHIFT, MADV_HUGEPAGE
+#endif
+
+#include <scq/detail/lock_free_cart_ids.hpp> // for cart_id_stack, cart_id_ring
+#include <scq/detail/numa_topology.hpp>      // for numa_topology, system_numa_topology
+#include <scq/detail/partition_kernels.hpp>  // for partitionable_value, partition_kernels, select_partition_kernels
 
 namespace scq
 {
 
+// The order in which full carts are handed out to the consumers.
+enum class cart_order
+{
+    lifo,       // the most recently filled cart first, i.e. its elements are likely still cached
+    fifo,       // the longest waiting cart first, which bounds the time a full cart waits for a consumer
+    round_robin // the longest waiting cart of each slot in turn, such that a hot slot cannot monopolise the consumers
+};
+
+// How a thread waits for an empty / full cart.
+enum class wait_strategy
+{
+    block,           // blocks on a condition variable right away, i.e. no CPU is used while waiting
+    spin,            // busy-spins until a cart is available, for the lowest latency at the cost of a core per waiter
+    spin_then_yield, // spins for a short time, afterwards yields the CPU between the checks but never blocks
+    spin_then_block  // spins for a short time, afterwards blocks on a condition variable
+};
+
+// The pages that back the cart memory of a queue, see params::huge_pages.
+enum class cart_memory_pages
+{
+    allocator,              // allocated from params::memory_resource
+    hugetlb,                // an anonymous mapping of huge pages from the huge page pool (MAP_HUGETLB)
+    transparent_huge_pages, // an anonymous mapping the kernel backs with transparent huge pages (MADV_HUGEPAGE)
+    regular                 // an anonymous mapping of regular pages, no kind of huge pages was available
+};
+
 struct params
 {
     size_t slots;
     size_t carts;
     size_t capacity;
+    // Number of locks that protect the slots; slot i is protected by lock i % lock_stripes.
+    // 0 means one lock per slot.
+    size_t lock_stripes{0};
+    // Whether enqueue_scatter partitions batches of 8-byte integers with the SIMD kernel of the best instruction set
+    // the CPU supports (AVX-512, AVX2); other value types always use the scalar partitioning.
+    bool simd_scatter{false};
+    scq::cart_order cart_order{scq::cart_order::lifo};
+    // Number of partitions the slots are split into; each partition is a contiguous range of slots. A consumer can
+    // dequeue the carts of a single partition.
+    size_t partitions{1};
+    // Whether at most one cart per slot is processed at a time: further full carts of a slot are held back until the
+    // cart_future (or cart_batch) of its previous cart was destroyed. Consumers can access per-slot state without
+    // locking.
+    bool exclusive_slots{false};
+    // How producers wait for an empty cart and consumers wait for a full cart.
+    scq::wait_strategy wait_strategy{scq::wait_strategy::block};
+    // Whether the full carts are kept in a lock-free ring buffer, such that consumers only take a lock if they have to
+    // wait. Requires cart_order::fifo, a single partition and no exclusive slots; dequeue_coalesced is not supported.
+    bool lock_free_full_carts{false};
+    // The memory resource that all storage of the queue is allocated from, i.e. the cart memory and the bookkeeping of
+    // the slots, the empty carts and the full carts. nullptr means std::pmr::get_default_resource().
+    std::pmr::memory_resource * memory_resource{nullptr};
+    // Whether the cart memory is an anonymous mmap that is backed by huge pages instead of being allocated from
+    // memory_resource (Linux only): pages of the huge page pool if it has enough free pages, otherwise transparent huge
+    // pages. cart_memory_pages() of the queue reports which pages it got.
+    bool huge_pages{false};
+    // Whether the empty carts are split into one pool per NUMA node (Linux, the nodes are read from
+    // /sys/devices/system/node): the cart memory of each pool is first touched by a thread on its node and producers
+    // take the empty carts of the node they run on first. Has no effect on systems with a single node.
+    bool numa_aware{false};
 };
 
 struct slots
@@ -50,22 +139,211 @@ struct slot_id
     size_t value;
 };
 
+struct lock_stripes
+{
+    size_t value;
+};
+
+struct partitions
+{
+    size_t value;
+};
+
+struct partition_id
+{
+    size_t value;
+};
+
+struct consumers
+{
+    size_t value;
+};
+
+// The result of the non-blocking queue operations.
+enum class queue_op_status
+{
+    ok,          // the operation succeeded
+    would_block, // the operation would have to wait for an empty / full cart
+    timeout,     // no empty / full cart became available before the deadline
+    closed       // the queue was closed (and, for dequeue operations, all carts were processed)
+};
+
+// Resumes the coroutines that were suspended by slotted_cart_queue::async_enqueue and async_dequeue, e.g. by posting
+// them to the thread pool of a coroutine scheduler.
+template <typename executor_t>
+concept coroutine_executor =
+    std::copy_constructible<executor_t> && std::invocable<executor_t &, std::coroutine_handle<>>;
+
+// Resumes the coroutine right away on the thread that made the cart available.
+struct inline_executor
+{
+    void operator()(std::coroutine_handle<> handle) const
+    {
+        handle.resume();
+    }
+};
+
+namespace detail
+{
+
+// The number of rounds a thread spins before it yields (wait_strategy::spin_then_yield) or blocks
+// (wait_strategy::spin_then_block).
+inline constexpr size_t spin_count{512u};
+
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// Spins until ready() holds. Returns false if the wait expired or, for wait_strategy::block and spin_then_block,
+// the thread should block instead.
+template <typename wait_t, typename ready_t>
+bool spin_until(scq::wait_strategy wait_strategy, wait_t const & wait, ready_t && ready)
+{
+    if (wait_strategy == scq::wait_strategy::block || wait.expired())
+        return false;
+
+    for (size_t round = 1u;; ++round)
+    {
+        if (ready())
+            return true;
+
+        if (round >= spin_count && wait_strategy == scq::wait_strategy::spin_then_block)
+            return false;
+
+        // the clock is only read every few rounds
+        if (round % 64u == 0u && wait.expired())
+            return false;
+
+        if (round >= spin_count && wait_strategy == scq::wait_strategy::spin_then_yield)
+            std::this_thread::yield();
+        else
+            cpu_relax();
+    }
+}
+
+// The size of the huge pages that params::huge_pages maps, i.e. the default huge page size of x86-64 and of aarch64
+// with 4 KiB pages. The size is requested explicitly, since the default size of the huge page pool may differ.
+inline constexpr size_t huge_page_shift{21u};
+inline constexpr size_t huge_page_size{size_t{1u} << huge_page_shift};
+
+// An anonymous memory mapping of at least size bytes that starts at a huge page boundary.
+struct huge_page_mapping
+{
+    void * data{nullptr};
+    size_t size{};
+    scq::cart_memory_pages pages{scq::cart_memory_pages::allocator};
+};
+
+#if defined(__linux__)
+// Whether transparent huge pages are not disabled system wide, i.e. the kernel follows madvise(MADV_HUGEPAGE).
+inline bool transparent_huge_pages_enabled()
+{
+    std::ifstream enabled_file{"/sys/kernel/mm/transparent_hugepage/enabled"};
+    std::string enabled{};
+    std::getline(enabled_file, enabled);
+
+    return enabled_file && enabled.find("[never]") == std::string::npos;
+}
+#endif
+
+// Maps huge pages of huge_page_size from the huge page pool (MAP_HUGETLB) and falls back to advising the kernel to use
+// transparent huge pages. Returns no mapping on other systems than Linux.
+inline huge_page_mapping map_huge_pages([[maybe_unused]] size_t size)
+{
+#if defined(__linux__)
+    size = (size + huge_page_size - 1u) / huge_page_size * huge_page_size;
+
+    int const protection = PROT_READ | PROT_WRITE;
+    int const flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#    if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+    // the size of the mapping is a multiple of the requested page size (MAP_HUGE_2MB), such that munmap succeeds
+    int const hugetlb_flags = MAP_HUGETLB | static_cast<int>(huge_page_shift << MAP_HUGE_SHIFT);
+
+    if (void * data = mmap(nullptr, size, protection, flags | hugetlb_flags, -1, 0); data != MAP_FAILED)
+        return {data, size, scq::cart_memory_pages::hugetlb};
+#    endif
+
+    // transparent huge pages only back the parts of a mapping that are aligned to huge pages, i.e. the mapping is
+    // over-allocated by a huge page and the unaligned head and tail are unmapped again
+    void * mapped = mmap(nullptr, size + huge_page_size, protection, flags, -1, 0);
+
+    if (mapped == MAP_FAILED)
+        throw std::bad_alloc{};
+
+    size_t const head_size = (huge_page_size - reinterpret_cast<uintptr_t>(mapped) % huge_page_size) % huge_page_size;
+    size_t const tail_size = huge_page_size - head_size;
+    std::byte * const begin = static_cast<std::byte *>(mapped) + head_size;
+
+    if (head_size != 0u)
+        munmap(mapped, head_size);
+
+    if (tail_size != 0u)
+        munmap(begin + size, tail_size);
+
+    scq::cart_memory_pages pages{scq::cart_memory_pages::regular};
+
+#    if defined(MADV_HUGEPAGE)
+    if (madvise(begin, size, MADV_HUGEPAGE) == 0 && transparent_huge_pages_enabled())
+        pages = scq::cart_memory_pages::transparent_huge_pages;
+#    endif
+
+    return {begin, size, pages};
+#else
+    return {};
+#endif
+}
+
+inline void unmap_huge_pages([[maybe_unused]] huge_page_mapping const & mapping)
+{
+#if defined(__linux__)
+    if (mapping.data != nullptr)
+    {
+        [[maybe_unused]] int const result = munmap(mapping.data, mapping.size);
+        assert(result == 0);
+    }
+#endif
+}
+
+} // namespace detail
+
 template <typename value_t>
 class slotted_cart_queue;
 
-template <typename value_t>
+// A full cart that was dequeued from cart_queue_t; the cart is returned to the queue once the cart_future is
+// destroyed.
+template <typename value_t, typename cart_queue_t = slotted_cart_queue<value_t>>
 class cart_future
 {
 public:
     cart_future() = default;
     cart_future(cart_future const &) = delete;
-    cart_future(cart_future &&) = default;
+    cart_future(cart_future && other) noexcept :
+        id{other.id},
+        memory_region{other.memory_region},
+        cart_queue{std::exchange(other.cart_queue, nullptr)}
+    {}
     cart_future & operator=(cart_future const &) = delete;
-    cart_future & operator=(cart_future &&) = default;
+    cart_future & operator=(cart_future && other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            id = other.id;
+            memory_region = other.memory_region;
+            cart_queue = std::exchange(other.cart_queue, nullptr);
+        }
+
+        return *this;
+    }
     ~cart_future()
     {
-        if (valid())
-            cart_queue->notify_processed_cart(*this);
+        release();
     }
 
     using value_type = value_t;
@@ -83,10 +361,153 @@ public:
         return {id, memory_region};
     }
 
+private:
+    friend cart_queue_t;
+
+    // a moved-from cart_future does not own the cart anymore, i.e. each cart is returned exactly once
+    void release()
+    {
+        if (valid())
+            std::exchange(cart_queue, nullptr)->notify_processed_cart(*this);
+    }
+
+    scq::slot_id id{};
+    std::span<value_type> memory_region{};
+
+    cart_queue_t * cart_queue{nullptr};
+};
+
+// Full carts that were dequeued at once, see slotted_cart_queue::dequeue_batch and
+// slotted_cart_queue::dequeue_coalesced. All carts of the batch are returned to the queue together once the batch is
+// destroyed.
+template <typename value_t>
+class cart_batch
+{
+public:
+    cart_batch() = default;
+    cart_batch(cart_batch const &) = delete;
+    cart_batch(cart_batch && other) noexcept :
+        full_carts{std::move(other.full_carts)},
+        cart_queue{std::exchange(other.cart_queue, nullptr)}
+    {}
+    cart_batch & operator=(cart_batch const &) = delete;
+    cart_batch & operator=(cart_batch && other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            full_carts = std::move(other.full_carts);
+            cart_queue = std::exchange(other.cart_queue, nullptr);
+        }
+
+        return *this;
+    }
+    ~cart_batch()
+    {
+        release();
+    }
+
+    using value_type = value_t;
+    using full_cart_type = std::pair<scq::slot_id, std::span<value_type>>;
+
+    bool valid() const
+    {
+        return cart_queue != nullptr;
+    }
+
+    std::span<full_cart_type const> get()
+    {
+        if (!valid()) // slotted_cart_queue is already closed and no further elements.
+            throw std::future_error{std::future_errc::no_state};
+
+        return full_carts;
+    }
+
+private:
+    template <typename>
+    friend class slotted_cart_queue;
+
+    void release()
+    {
+        if (valid())
+            std::exchange(cart_queue, nullptr)->notify_processed_carts(*this);
+    }
+
+    std::vector<full_cart_type> full_carts{};
+
+    slotted_cart_queue<value_type> * cart_queue{nullptr};
+};
+
+// A writable region within the current cart of a slot, see slotted_cart_queue::reserve. The elements are filled in
+// place and handed over to the queue by commit; a reservation that is destroyed without being committed commits no
+// elements.
+template <typename value_t>
+class cart_reservation
+{
+public:
+    cart_reservation() = default;
+    cart_reservation(cart_reservation const &) = delete;
+    cart_reservation(cart_reservation && other) noexcept :
+        id{other.id},
+        memory_region{other.memory_region},
+        cart_queue{std::exchange(other.cart_queue, nullptr)}
+    {}
+    cart_reservation & operator=(cart_reservation const &) = delete;
+    cart_reservation & operator=(cart_reservation && other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            id = other.id;
+            memory_region = other.memory_region;
+            cart_queue = std::exchange(other.cart_queue, nullptr);
+        }
+
+        return *this;
+    }
+    ~cart_reservation()
+    {
+        release();
+    }
+
+    using value_type = value_t;
+
+    bool valid() const
+    {
+        return cart_queue != nullptr;
+    }
+
+    std::span<value_type> get()
+    {
+        if (!valid()) // slotted_cart_queue is already closed or the reservation was committed.
+            throw std::future_error{std::future_errc::no_state};
+
+        return memory_region;
+    }
+
+    // Hands the first count elements of the reservation over to the queue; the remaining positions can be reserved
+    // by the next producer of the slot. Invalidates the reservation.
+    void commit(size_t count)
+    {
+        if (!valid())
+            throw std::future_error{std::future_errc::no_state};
+
+        if (count > memory_region.size())
+            throw std::logic_error{"Cannot commit more elements than were reserved."};
+
+        std::exchange(cart_queue, nullptr)->commit_reservation(*this, count);
+    }
+
 private:
     template <typename>
     friend class slotted_cart_queue;
 
+    void release()
+    {
+        if (valid())
+            std::exchange(cart_queue, nullptr)->commit_reservation(*this, 0u);
+    }
+
     scq::slot_id id{};
     std::span<value_type> memory_region{};
 
@@ -108,6 +529,8 @@ class slotted_cart_queue
 public:
     using value_type = value_t;
     using cart_future_type = cart_future<value_type>;
+    using cart_reservation_type = cart_reservation<value_type>;
+    using cart_batch_type = cart_batch<value_type>;
 
     slotted_cart_queue() = default;
     slotted_cart_queue(slotted_cart_queue const &) = delete;
@@ -118,398 +541,2668 @@ public:
     slotted_cart_queue(params params) :
         slot_count{params.slots},
         cart_count{params.carts},
-        cart_capacity{params.capacity}
+        cart_capacity{params.capacity},
+        lock_stripe_count{params.lock_stripes == 0u ? params.slots : params.lock_stripes},
+        partition_count{params.partitions},
+        exclusive_slots{params.exclusive_slots},
+        wait_strategy{params.wait_strategy},
+        lock_free_full_carts{params.lock_free_full_carts},
+        simd_scatter{params.simd_scatter},
+        cart_order{params.cart_order},
+        memory_resource{params.memory_resource != nullptr ? params.memory_resource : std::pmr::get_default_resource()},
+        huge_pages{params.huge_pages},
+        numa_topology{params.numa_aware && detail::system_numa_topology().node_count() > 1u
+                          ? &detail::system_numa_topology()
+                          : nullptr}
     {
         if (cart_count < slot_count)
             throw std::logic_error{"The number of carts must be >= the number of slots."};
 
         if (cart_capacity == 0u)
             throw std::logic_error{"The cart capacity must be >= 1."};
-    }
-
-    void enqueue(slot_id slot, value_type value)
-    {
-        using full_cart_type = typename full_carts_queue_t::full_cart_type;
-
-        bool full_queue_was_empty{};
-        bool queue_was_closed{};
-
-        std::optional<full_cart_type> full_cart{};
 
-        {
-            std::unique_lock<std::mutex> cart_management_lock(cart_management_mutex);
+        if (cart_count > cart_slots_t::max_cart_count)
+            throw std::logic_error{"The number of carts must be < 2^32 - 1."};
 
-            queue_was_closed = queue_closed;
+        if (cart_capacity > cart_slots_t::max_cart_capacity)
+            throw std::logic_error{"The cart capacity must be <= 2^31."};
 
-            auto slot_cart = cart_slots.slot(slot);
+        if (partition_count == 0u || partition_count > slot_count)
+            throw std::logic_error{"The number of partitions must be >= 1 and <= the number of slots."};
 
-            if (!queue_was_closed && slot_cart.empty())
-            {
-                empty_cart_queue_empty_or_closed_cv.wait(cart_management_lock,
-                                                         [this, &slot_cart]
-                                                         {
-                                                             // wait until either an empty cart is ready, or the slot has a cart, or the queue was closed
-                                                             return !empty_carts_queue.empty() || !slot_cart.empty()
-                                                                 || queue_closed == true;
-                                                         });
-
-                queue_was_closed = queue_closed;
-
-                // if the current slot still has no cart and we have an available empty cart, use that empty cart in
-                // this slot
-                if (!queue_was_closed && slot_cart.empty())
-                {
-                    // this assert must be true because of the condition within empty_cart_queue_empty_or_closed_cv
-                    assert(!empty_carts_queue.empty());
+        if (lock_free_full_carts
+            && (cart_order != scq::cart_order::fifo || partition_count != 1u || exclusive_slots))
+            throw std::logic_error{"Lock-free full carts need cart_order::fifo, one partition and no exclusive slots."};
 
-                    std::span<value_t> memory_region = empty_carts_queue.dequeue();
-                    slot_cart.set_memory_region(memory_region);
-                    assert_cart_count_variant();
-                }
-            }
+        if (numa_topology != nullptr)
+            first_touch_cart_memory();
+    }
 
-            if (!queue_was_closed)
-            {
-                slot_cart.emplace_back(std::move(value));
+    ~slotted_cart_queue()
+    {
+        // the consumer threads only finish once the queue is closed
+        if (!consumer_threads.empty())
+        {
+            close();
 
-                if (slot_cart.full())
-                {
-                    full_cart = full_carts_queue_t::move_slot_cart_to_full_cart(slot_cart);
-                }
-            }
+            for (std::thread & consumer_thread : consumer_threads)
+                consumer_thread.join();
         }
 
-        if (full_cart.has_value())
+        // destroy the elements of all carts that were not processed
+        if constexpr (!std::is_trivially_destructible_v<value_type>)
         {
-            std::unique_lock<std::mutex> full_cart_queue_lock(full_cart_queue_mutex);
-
-            full_queue_was_empty = full_carts_queue.empty();
+            for (size_t slot_id = 0u; slot_id < slot_count; ++slot_id)
+            {
+                if (auto cart_id = cart_slots.seal(scq::slot_id{slot_id}); cart_id.has_value())
+                    std::ranges::destroy(queue_memory.memory_region(*cart_id).first(cart_slots.cart_size(*cart_id)));
+            }
 
-            // enqueue later
-            full_carts_queue.enqueue(std::move(*full_cart));
-            assert_cart_count_variant();
+            full_carts_queue.for_each_cart(
+                [](typename full_carts_queue_t::full_cart_type const & full_cart)
+                {
+                    std::ranges::destroy(full_cart.second);
+                });
         }
+    }
 
-        if (full_queue_was_empty)
-            full_cart_queue_empty_or_closed_cv.notify_all();
+    void enqueue(slot_id slot, value_type value)
+    {
+        emplace(slot, std::move(value));
+    }
 
-        if (queue_was_closed)
+    // Constructs the element directly within the cart memory of the slot.
+    template <typename... args_t>
+        requires std::constructible_from<value_type, args_t...>
+    void emplace(slot_id slot, args_t &&... args)
+    {
+        if (enqueue_with(slot, wait_indefinitely{}, std::forward<args_t>(args)...) == queue_op_status::closed)
             throw std::overflow_error{"slotted_cart_queue is already closed."};
     }
 
-    cart_future_type dequeue()
+    // Enqueues all elements of the range into the given slot. In contrast to calling enqueue for each element, the
+    // positions within a cart are reserved at once for as many elements as fit into the cart. Elements are constructed
+    // from the range's reference type, i.e. they are moved if the range yields rvalues (e.g. std::move_iterator).
+    // Returns the number of enqueued elements, which is less than the size of the range if the queue was closed.
+    template <std::ranges::input_range range_t>
+        requires std::constructible_from<value_type, std::ranges::range_reference_t<range_t>>
+    size_t enqueue_range(slot_id slot, range_t && range)
     {
-        cart_future_type cart_future{};
+        size_t enqueued_count{};
 
-        {
-            std::unique_lock<std::mutex> full_cart_queue_lock(full_cart_queue_mutex);
+        auto it = std::ranges::begin(range);
+        auto end = std::ranges::end(range);
 
-            full_cart_queue_empty_or_closed_cv.wait(full_cart_queue_lock,
-                                                    [this]
-                                                    {
-                                                        // wait until first cart is full
-                                                        return !full_carts_queue.empty() || queue_closed == true;
-                                                    });
-
-            if (!full_carts_queue.empty())
+        auto construct_from_range = [&it](std::span<value_type> memory_region) noexcept
+        {
+            for (value_type & value : memory_region)
             {
-                auto full_cart = full_carts_queue.dequeue();
-                cart_future.id = full_cart.first;
-                cart_future.memory_region = std::move(full_cart.second);
-                cart_future.cart_queue = this;
-                assert_cart_count_variant();
+                std::construct_at(std::addressof(value), *it);
+                ++it;
             }
+        };
+
+        if constexpr (!is_nothrow_constructible_from_iterator<std::ranges::iterator_t<range_t>>)
+        {
+            // a reserved position must hold an element, i.e. elements are constructed one by one before reserving
+            // their position if the construction might throw
+            for (; it != end && enqueue_with(slot, wait_indefinitely{}, *it) == queue_op_status::ok; ++it)
+                ++enqueued_count;
+        }
+        else if constexpr (std::ranges::forward_range<range_t>)
+        {
+            enqueued_count = enqueue_n(slot, static_cast<size_t>(std::ranges::distance(range)), construct_from_range);
+        }
+        else // we can only reserve as many positions as we are able to fill
+        {
+            for (; it != end && enqueue_n(slot, 1u, construct_from_range) == 1u;)
+                ++enqueued_count;
         }
 
-        // NOTE: cart memory will be released by notify_processed_cart after cart_future was destroyed
-        return cart_future;
+        return enqueued_count;
     }
 
-    void close()
+    // Enqueues each value into the slot with the same index. The batch is partitioned by slot first (counting sort),
+    // such that the positions for all values of a slot are reserved at once per cart instead of once per value. Values
+    // of the same slot keep their relative order.
+    // Returns the number of enqueued elements, which is less than the size of the batch if the queue was closed.
+    size_t enqueue_scatter(std::span<slot_id const> slots, std::span<value_type const> values)
     {
+        if (slots.size() != values.size())
+            throw std::logic_error{"The number of slot ids must be equal to the number of values."};
+
+        if constexpr (detail::partitionable_value<value_type>)
         {
-            // this locks the whole queue
-            std::scoped_lock lock(cart_management_mutex, full_cart_queue_mutex);
+            if (simd_scatter)
+                return enqueue_scatter_simd(slots, values);
+        }
 
-            queue_closed = true;
-            cart_slots.move_active_carts_into_full_carts_queue(full_carts_queue);
-            assert_cart_count_variant();
+        // counting pass: slot_offsets[slot_id + 1] is the number of values of the slot
+        std::vector<size_t> slot_offsets(slot_count + 1u);
+        for (slot_id slot : slots)
+        {
+            assert(slot.value < slot_count);
+            ++slot_offsets[slot.value + 1u];
         }
 
-        empty_cart_queue_empty_or_closed_cv.notify_all();
-        full_cart_queue_empty_or_closed_cv.notify_all();
-    }
+        // prefix sum: the values of a slot are at [slot_offsets[slot_id], slot_offsets[slot_id + 1]) within value_order
+        std::inclusive_scan(slot_offsets.begin(), slot_offsets.end(), slot_offsets.begin());
 
-private:
-    size_t slot_count{};
-    size_t cart_count{};
-    size_t cart_capacity{};
+        std::vector<size_t> value_order(values.size());
+        {
+            std::vector<size_t> next_positions(slot_offsets.begin(), slot_offsets.end() - 1);
+            for (size_t i = 0u; i < slots.size(); ++i)
+                value_order[next_positions[slots[i].value]++] = i;
+        }
 
-    queue_memory_t queue_memory{scq::carts{cart_count}, scq::capacity{cart_capacity}};
-    empty_carts_queue_t empty_carts_queue{scq::carts{cart_count}, queue_memory};
-    full_carts_queue_t full_carts_queue{scq::carts{cart_count}};
+        if constexpr (std::is_nothrow_copy_constructible_v<value_type>)
+        {
+            return enqueue_partitions(slot_offsets,
+                                      [&values, &value_order](size_t begin)
+                                      {
+                                          return [&values, it = value_order.begin() + begin](
+                                                     std::span<value_type> memory_region) mutable noexcept
+                                          {
+                                              for (value_type & value : memory_region)
+                                                  std::construct_at(std::addressof(value), values[*it++]);
+                                          };
+                                      });
+        }
+        else
+        {
+            size_t enqueued_count{};
 
-    friend cart_future_type;
+            // a reserved position must hold an element, i.e. each value is copied before reserving its position
+            for (size_t slot_id = 0u; slot_id < slot_count; ++slot_id)
+            {
+                for (size_t position = slot_offsets[slot_id]; position < slot_offsets[slot_id + 1u]; ++position)
+                {
+                    if (enqueue_with(scq::slot_id{slot_id}, wait_indefinitely{}, values[value_order[position]])
+                        != queue_op_status::ok)
+                        return enqueued_count;
 
-    void assert_cart_count_variant()
-    {
-        empty_carts_queue.check_invariant();
-        full_carts_queue.check_invariant();
+                    ++enqueued_count;
+                }
+            }
+
+            return enqueued_count;
+        }
     }
 
-    void notify_processed_cart(cart_future_type & cart_future)
+    // Reserves up to count positions within the current cart of the slot, which are filled in place and handed over by
+    // cart_reservation::commit. The elements of the reservation are default-initialised, i.e. they are uninitialised
+    // for trivial types. The other producers of the slot wait until the reservation was committed, i.e. the caller
+    // must not enqueue into the same slot before committing.
+    // close() waits until all reservations were committed (or destroyed), i.e. the thread that holds a reservation must
+    // not call close() before committing it; otherwise, close() never returns.
+    // Returns an invalid reservation if the queue was closed.
+    cart_reservation_type reserve(slot_id slot, size_t count)
+        requires std::is_nothrow_default_constructible_v<value_type>
     {
-        bool empty_queue_was_empty{};
+        if (count == 0u)
+            throw std::logic_error{"The reservation must comprise at least one element."};
+
+        cart_reservation_type cart_reservation{};
+
+        do
         {
-            std::unique_lock<std::mutex> cart_management_lock(cart_management_mutex);
+            std::unique_lock<std::mutex> slot_lock = cart_slots.lock(slot);
 
-            empty_queue_was_empty = empty_carts_queue.empty();
+            // another reservation of the slot is pending or a producer fetches a new cart
+            cart_slots.wait_until_cart_set(slot_lock, slot, wait_indefinitely{});
 
-            empty_carts_queue.enqueue(cart_future.memory_region);
-            assert_cart_count_variant();
+            if (queue_closed)
+                break;
+
+            if (auto reservation = cart_slots.detach(slot, count); reservation.count > 0u)
+            {
+                // the other producers of the slot wait until the cart was reattached by commit_reservation
+                cart_slots.set_cart_requested(slot, true);
+
+                cart_reservation.id = slot;
+                cart_reservation.memory_region = reserved_memory_region(reservation);
+                cart_reservation.cart_queue = this;
+                std::ranges::uninitialized_default_construct(cart_reservation.memory_region);
+                break;
+            }
         }
+        while (wait_for_slot_cart(slot, wait_indefinitely{}) == queue_op_status::ok); // the cart is full, set a new one
 
-        if (empty_queue_was_empty)
-            empty_cart_queue_empty_or_closed_cv.notify_all();
+        return cart_reservation;
     }
 
-    std::atomic_bool queue_closed{false};
-
-    cart_slots_t cart_slots{scq::slots{slot_count}, scq::capacity{cart_capacity}};
+    // Does not block; returns queue_op_status::would_block if no empty cart is available for the slot. The value is
+    // only moved from if it was enqueued.
+    queue_op_status try_enqueue(slot_id slot, value_type && value)
+    {
+        return would_block_on_timeout(enqueue_with(slot, dont_wait{}, std::move(value)));
+    }
 
-    std::mutex cart_management_mutex;
-    std::condition_variable empty_cart_queue_empty_or_closed_cv;
-    std::mutex full_cart_queue_mutex;
-    std::condition_variable full_cart_queue_empty_or_closed_cv;
-};
+    queue_op_status try_enqueue(slot_id slot, value_type const & value)
+    {
+        return would_block_on_timeout(enqueue_with(slot, dont_wait{}, value));
+    }
 
-template <typename value_t>
-struct slotted_cart_queue<value_t>::queue_memory_t
-{
-    queue_memory_t() = default;
-    queue_memory_t(scq::carts carts, scq::capacity capacity) :
-        cart_capacity{capacity.value},
-        internal_queue_memory(carts.value * capacity.value)
-    {}
+    // Blocks at most until the deadline; returns queue_op_status::timeout if no empty cart became available for the
+    // slot in time. The value is only moved from if it was enqueued.
+    template <typename clock_t, typename duration_t>
+    queue_op_status enqueue_until(slot_id slot,
+                                  value_type && value,
+                                  std::chrono::time_point<clock_t, duration_t> const & deadline)
+    {
+        return enqueue_with(slot, wait_until_deadline<clock_t, duration_t>{deadline}, std::move(value));
+    }
 
-    std::span<value_t> memory_region(cart_memory_id cart_memory_id)
+    template <typename clock_t, typename duration_t>
+    queue_op_status enqueue_until(slot_id slot,
+                                  value_type const & value,
+                                  std::chrono::time_point<clock_t, duration_t> const & deadline)
     {
-        size_t size = cart_capacity;
-        value_t * begin = internal_queue_memory.data() + cart_memory_id.value * size;
-        return {begin, size};
+        return enqueue_with(slot, wait_until_deadline<clock_t, duration_t>{deadline}, value);
     }
 
-    size_t cart_capacity{};
+    template <typename rep_t, typename period_t>
+    queue_op_status
+    enqueue_for(slot_id slot, value_type && value, std::chrono::duration<rep_t, period_t> const & timeout)
+    {
+        return enqueue_until(slot, std::move(value), std::chrono::steady_clock::now() + timeout);
+    }
 
-    std::vector<value_t> internal_queue_memory{};
-};
+    template <typename rep_t, typename period_t>
+    queue_op_status
+    enqueue_for(slot_id slot, value_type const & value, std::chrono::duration<rep_t, period_t> const & timeout)
+    {
+        return enqueue_until(slot, value, std::chrono::steady_clock::now() + timeout);
+    }
 
-template <typename value_t>
+    cart_future_type dequeue()
+    {
+        cart_future_type cart_future{};
+
+        // blocks until the first cart is full or the queue was closed
+        dequeue_with(cart_future, full_carts_queue_t::any_partition, wait_indefinitely{});
+
+        // NOTE: cart memory will be released by notify_processed_cart after cart_future was destroyed
+        return cart_future;
+    }
+
+    // Only dequeues carts of the slots within the partition, see partition_of.
+    cart_future_type dequeue(partition_id partition)
+    {
+        assert(partition.value < partition_count);
+
+        cart_future_type cart_future{};
+        dequeue_with(cart_future, partition.value, wait_indefinitely{});
+        return cart_future;
+    }
+
+    // The partition a slot belongs to; the partitions split the slots into contiguous ranges of (almost) equal size.
+    partition_id partition_of(slot_id slot) const
+    {
+        assert(slot.value < slot_count);
+        return {full_carts_queue.partition_of(slot)};
+    }
+
+    // Blocks until at least one cart is full and dequeues up to max_count full carts in one go. The carts are returned
+    // to the queue together when the batch is destroyed; a consumer should destroy its previous batch before dequeueing
+    // the next one, otherwise the producers might run out of empty carts.
+    // Returns an invalid batch if the queue was closed and all carts were processed.
+    cart_batch_type dequeue_batch(size_t max_count)
+    {
+        return dequeue_batch_of(max_count, full_carts_queue_t::any_partition);
+    }
+
+    // Only dequeues carts of the slots within the partition, see partition_of.
+    cart_batch_type dequeue_batch(size_t max_count, partition_id partition)
+    {
+        assert(partition.value < partition_count);
+        return dequeue_batch_of(max_count, partition.value);
+    }
+
+    // Blocks until at least one cart is full and dequeues it together with all other full carts of its slot, such that
+    // a consumer sets up its per-slot state once for all of them. All carts of the batch belong to the same slot; with
+    // exclusive slots, the batch also comprises the held back carts of the slot.
+    // Returns an invalid batch if the queue was closed and all carts were processed.
+    cart_batch_type dequeue_coalesced()
+    {
+        return dequeue_coalesced_of(full_carts_queue_t::any_partition);
+    }
+
+    // Only dequeues carts of the slots within the partition, see partition_of.
+    cart_batch_type dequeue_coalesced(partition_id partition)
+    {
+        assert(partition.value < partition_count);
+        return dequeue_coalesced_of(partition.value);
+    }
+
+    // Does not block; returns queue_op_status::would_block if no full cart is available. The cart_future is only
+    // assigned if a cart was dequeued.
+    queue_op_status try_dequeue(cart_future_type & cart_future)
+    {
+        return would_block_on_timeout(dequeue_with(cart_future, full_carts_queue_t::any_partition, dont_wait{}));
+    }
+
+    // Blocks at most until the deadline; returns queue_op_status::timeout if no full cart became available in time.
+    // The cart_future is only assigned if a cart was dequeued.
+    template <typename clock_t, typename duration_t>
+    queue_op_status dequeue_until(cart_future_type & cart_future,
+                                  std::chrono::time_point<clock_t, duration_t> const & deadline)
+    {
+        return dequeue_with(cart_future,
+                            full_carts_queue_t::any_partition,
+                            wait_until_deadline<clock_t, duration_t>{deadline});
+    }
+
+    template <typename rep_t, typename period_t>
+    queue_op_status dequeue_for(cart_future_type & cart_future, std::chrono::duration<rep_t, period_t> const & timeout)
+    {
+        return dequeue_until(cart_future, std::chrono::steady_clock::now() + timeout);
+    }
+
+    // co_await yields the cart_future, which is invalid if the queue was closed and all carts were processed.
+    template <coroutine_executor executor_t>
+    class dequeue_awaiter;
+
+    // co_await yields queue_op_status::ok or queue_op_status::closed if the value could not be enqueued.
+    template <coroutine_executor executor_t>
+    class enqueue_awaiter;
+
+    // Awaitable version of dequeue: Instead of blocking the thread, the coroutine is suspended until a cart is full and
+    // resumed via the executor by the thread that published the cart.
+    template <coroutine_executor executor_t = inline_executor>
+    dequeue_awaiter<executor_t> async_dequeue(executor_t executor = {})
+    {
+        return dequeue_awaiter<executor_t>{*this, std::move(executor)};
+    }
+
+    // Awaitable version of enqueue: Instead of blocking the thread, the coroutine is suspended until an empty cart is
+    // available for the slot. The enqueue is retried by the thread that returned an empty cart (or set a cart for a
+    // slot), which resumes the coroutine via the executor once the value was enqueued.
+    template <coroutine_executor executor_t = inline_executor>
+    enqueue_awaiter<executor_t> async_enqueue(slot_id slot, value_type value, executor_t executor = {})
+    {
+        return enqueue_awaiter<executor_t>{*this, slot, std::move(value), std::move(executor)};
+    }
+
+    // Runs handler(slot, memory_region) for each full cart on consumers.value threads that are owned by the queue. An
+    // idle consumer thread is handed a full cart directly by the thread that published it. If cpus is not empty,
+    // consumer thread i is pinned to the CPU cpus[i % cpus.size()] (only on Linux). The consumer threads finish once
+    // the queue was closed and all carts were processed, see join_consumers.
+    template <typename handler_t>
+        requires std::copy_constructible<handler_t> && std::invocable<handler_t &, slot_id, std::span<value_type>>
+    void start_consumers(scq::consumers consumers, handler_t handler, std::span<size_t const> cpus = {})
+    {
+        if (!consumer_threads.empty())
+            throw std::logic_error{"The consumers were already started."};
+
+        if (consumers.value == 0u)
+            throw std::logic_error{"The number of consumers must be >= 1."};
+
+#if defined(__linux__)
+        if (std::ranges::any_of(cpus,
+                                [](size_t cpu)
+                                {
+                                    return cpu >= CPU_SETSIZE;
+                                }))
+            throw std::logic_error{"The CPUs must be < CPU_SETSIZE."};
+#endif
+
+        consumer_threads.reserve(consumers.value);
+
+        for (size_t i = 0u; i < consumers.value; ++i)
+        {
+            // each consumer thread has its own copy of the handler
+            consumer_threads.emplace_back(
+                [this, handler]() mutable
+                {
+                    consume_all(handler);
+                });
+
+            if (!cpus.empty())
+                pin_to_cpu(consumer_threads.back(), cpus[i % cpus.size()]);
+        }
+    }
+
+    // Waits until the consumer threads processed all carts, i.e. close() must be called before (or concurrently).
+    // Rethrows the first exception that was thrown by a handler; the carts of the other calls were processed anyway.
+    void join_consumers()
+    {
+        for (std::thread & consumer_thread : consumer_threads)
+            consumer_thread.join();
+
+        consumer_threads.clear();
+
+        if (consumer_exception)
+            std::rethrow_exception(std::exchange(consumer_exception, nullptr));
+    }
+
+    // Publishes all non-empty carts and releases the waiting producers and consumers. Waits until the pending
+    // reservations (see reserve) were committed, i.e. must not be called by a thread that holds a reservation.
+    void close()
+    {
+        // producers check this flag while holding their slot lock, i.e. after this point no new cart will be set
+        queue_closed = true;
+
+        // release producers that wait for an empty cart
+        empty_carts_queue.close();
+
+        // seal all non-empty / non-full carts; a sealed cart is published by its last committing producer
+        for (size_t slot_id = 0u; slot_id < slot_count; ++slot_id)
+        {
+            if (auto cart_id = cart_slots.seal(scq::slot_id{slot_id}); cart_id.has_value())
+                publish_cart(scq::slot_id{slot_id}, *cart_id);
+        }
+
+        // producers that reserved a position before the carts were sealed might still write their elements
+        cart_slots.wait_until_all_carts_published();
+
+        // release consumers only after all pending carts were handed over
+        full_carts_queue.close();
+    }
+
+    // The pages that back the cart memory, see params::huge_pages.
+    scq::cart_memory_pages cart_memory_pages() const
+    {
+        return queue_memory.mapping.pages;
+    }
+
+private:
+    size_t slot_count{};
+    size_t cart_count{};
+    size_t cart_capacity{};
+    size_t lock_stripe_count{};
+    size_t partition_count{};
+    bool exclusive_slots{};
+    scq::wait_strategy wait_strategy{};
+    bool lock_free_full_carts{};
+    bool simd_scatter{};
+    scq::cart_order cart_order{};
+    std::pmr::memory_resource * memory_resource{std::pmr::get_default_resource()};
+    bool huge_pages{};
+    detail::numa_topology const * numa_topology{nullptr}; // numa_aware: the nodes, nullptr on a single node
+
+    queue_memory_t queue_memory{scq::carts{cart_count}, scq::capacity{cart_capacity}, memory_resource, huge_pages};
+    empty_carts_queue_t empty_carts_queue{scq::carts{cart_count}, wait_strategy, memory_resource, numa_topology};
+    full_carts_queue_t full_carts_queue{scq::slots{slot_count},
+                                        scq::carts{cart_count},
+                                        scq::partitions{partition_count},
+                                        cart_order,
+                                        exclusive_slots,
+                                        wait_strategy,
+                                        lock_free_full_carts,
+                                        memory_resource};
+
+    friend cart_future_type;
+    friend cart_reservation_type;
+    friend cart_batch_type;
+
+    // A coroutine that is suspended in async_enqueue or async_dequeue. The waiters are linked into an intrusive list of
+    // the empty / full carts queue and are woken up after the lock of that queue was released.
+    struct async_waiter_t
+    {
+        async_waiter_t * next{nullptr};
+        void (*wake)(async_waiter_t &){nullptr};
+    };
+
+    struct async_dequeue_waiter_t : async_waiter_t
+    {
+        std::pair<slot_id, std::span<value_t>> full_cart{};
+        queue_op_status status{queue_op_status::would_block};
+    };
+
+    struct async_waiter_list_t
+    {
+        bool empty() const
+        {
+            return first == nullptr;
+        }
+
+        void push_back(async_waiter_t & waiter)
+        {
+            waiter.next = nullptr;
+
+            if (empty())
+                first = &waiter;
+            else
+                last->next = &waiter;
+
+            last = &waiter;
+        }
+
+        async_waiter_t & pop_front()
+        {
+            assert(!empty());
+
+            async_waiter_t & waiter = *std::exchange(first, first->next);
+
+            if (empty())
+                last = nullptr;
+
+            return waiter;
+        }
+
+        // A woken waiter might be resumed and destroyed right away, i.e. its successor is read before waking it.
+        void wake_all() &&
+        {
+            while (!empty())
+            {
+                async_waiter_t & waiter = pop_front();
+                waiter.wake(waiter);
+            }
+        }
+
+        async_waiter_t * first{nullptr};
+        async_waiter_t * last{nullptr};
+    };
+
+    // A consumer thread of start_consumers that waits for a full cart.
+    struct consumer_waiter_t : async_dequeue_waiter_t
+    {
+        std::binary_semaphore woken{0};
+    };
+
+    template <typename handler_t>
+    void consume_all(handler_t & handler)
+    {
+        consumer_waiter_t waiter{};
+        waiter.wake = [](async_waiter_t & woken_waiter)
+        {
+            static_cast<consumer_waiter_t &>(woken_waiter).woken.release();
+        };
+
+        while (true)
+        {
+            if (full_carts_queue.suspend_dequeue(waiter))
+                waiter.woken.acquire();
+
+            if (waiter.status != queue_op_status::ok) // closed and all carts were processed
+                return;
+
+            // the cart is returned to the queue even if the handler throws
+            cart_future_type cart_future = make_cart_future(waiter.full_cart);
+
+            try
+            {
+                handler(waiter.full_cart.first, waiter.full_cart.second);
+            }
+            catch (...)
+            {
+                std::scoped_lock consumer_exception_lock{consumer_exception_mutex};
+
+                if (!consumer_exception)
+                    consumer_exception = std::current_exception();
+            }
+        }
+    }
+
+    static void pin_to_cpu([[maybe_unused]] std::thread & thread, [[maybe_unused]] size_t cpu)
+    {
+#if defined(__linux__)
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+
+        if (int const error = pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set); error != 0)
+            throw std::system_error{error, std::generic_category(), "Could not pin the consumer thread to its CPU"};
+#endif
+    }
+
+    // Writes to each page of the carts of each pool on a thread of the pool's node, such that the kernel places the
+    // pages on that node (first touch). Pages that were already touched, e.g. by the memory_resource, stay where they
+    // are. A page that is shared by two pools goes to the node that touches it first.
+    void first_touch_cart_memory()
+    {
+        // pages are at least 4 KiB
+        static constexpr size_t page_size{4096u};
+
+        numa_topology->run_on_each_node(
+            [this](size_t node)
+            {
+                auto [first_cart, last_cart] = empty_carts_queue.pool_carts(node);
+                size_t const begin = first_cart * queue_memory.cart_stride;
+                size_t const end = last_cart * queue_memory.cart_stride;
+
+                // each page that overlaps [begin, end); the touched byte is within the pool's own carts
+                for (size_t page = begin / page_size * page_size; page < end; page += page_size)
+                    queue_memory.internal_queue_memory[std::max(page, begin)] = std::byte{};
+            });
+    }
+
+    cart_future_type make_cart_future(std::pair<slot_id, std::span<value_t>> const & full_cart)
+    {
+        cart_future_type cart_future{};
+        cart_future.id = full_cart.first;
+        cart_future.memory_region = full_cart.second;
+        cart_future.cart_queue = this;
+        return cart_future;
+    }
+
+    void notify_processed_cart(cart_future_type & cart_future)
+    {
+        std::ranges::destroy(cart_future.memory_region);
+        empty_carts_queue.enqueue(queue_memory.cart_id(cart_future.memory_region));
+
+        if (exclusive_slots)
+            full_carts_queue.release_slots(std::span<slot_id const>{&cart_future.id, 1u});
+    }
+
+    void notify_processed_carts(cart_batch_type & cart_batch)
+    {
+        for (auto && [slot, memory_region] : cart_batch.full_carts)
+            std::ranges::destroy(memory_region);
+
+        empty_carts_queue.enqueue_range(cart_batch.full_carts
+                                        | std::views::transform(
+                                            [this](typename cart_batch_type::full_cart_type const & full_cart)
+                                            {
+                                                return queue_memory.cart_id(full_cart.second);
+                                            }));
+
+        if (exclusive_slots)
+            full_carts_queue.release_slots(cart_batch.full_carts | std::views::keys);
+    }
+
+    // Reattaches the cart of the reservation to its slot behind the count committed elements and wakes up the other
+    // producers of the slot.
+    void commit_reservation(cart_reservation_type & cart_reservation, size_t count)
+    {
+        std::span<value_type> const memory_region = cart_reservation.memory_region;
+        std::ranges::destroy(memory_region.subspan(count));
+
+        typename cart_slots_t::reservation_t reservation{};
+
+        {
+            std::unique_lock<std::mutex> slot_lock = cart_slots.lock(cart_reservation.id);
+
+            reservation = cart_slots.reattach(cart_reservation.id,
+                                              {queue_memory.cart_id(memory_region),
+                                               queue_memory.position(memory_region),
+                                               count},
+                                              queue_closed);
+
+            cart_slots.set_cart_requested(cart_reservation.id, false);
+            cart_slots.notify_all(cart_reservation.id);
+        }
+
+        commit(cart_reservation.id, reservation);
+    }
+
+    // The waits of the blocking operations: Each waits on the condition variable until the predicate holds. Returns
+    // false if it gave up waiting, which the operations report as queue_op_status::timeout. Before blocking, the
+    // threads might spin according to the wait_strategy as long as the wait did not expire.
+    struct wait_indefinitely
+    {
+        template <typename predicate_t>
+        bool operator()(std::condition_variable & cv, std::unique_lock<std::mutex> & lock, predicate_t predicate) const
+        {
+            cv.wait(lock, std::move(predicate));
+            return true;
+        }
+
+        bool expired() const
+        {
+            return false;
+        }
+    };
+
+    template <typename clock_t, typename duration_t>
+    struct wait_until_deadline
+    {
+        template <typename predicate_t>
+        bool operator()(std::condition_variable & cv, std::unique_lock<std::mutex> & lock, predicate_t predicate) const
+        {
+            return cv.wait_until(lock, deadline, std::move(predicate));
+        }
+
+        bool expired() const
+        {
+            return clock_t::now() >= deadline;
+        }
+
+        std::chrono::time_point<clock_t, duration_t> deadline;
+    };
+
+    struct dont_wait
+    {
+        template <typename predicate_t>
+        bool operator()(std::condition_variable &, std::unique_lock<std::mutex> &, predicate_t predicate) const
+        {
+            return predicate();
+        }
+
+        bool expired() const
+        {
+            return true;
+        }
+    };
+
+    // Spins until predicate() holds, which is checked while holding the lock. While spinning, the lock is released
+    // and the thread spins on hint(), which must not need the lock; the predicate is only checked once the hint holds.
+    // Returns predicate() with the lock being locked; if it does not hold, the thread should block or the wait expired.
+    template <typename wait_t, typename predicate_t, typename hint_t>
+    static bool spin_locked_until(scq::wait_strategy wait_strategy,
+                                  wait_t const & wait,
+                                  std::unique_lock<std::mutex> & lock,
+                                  predicate_t && predicate,
+                                  hint_t && hint)
+    {
+        if (predicate())
+            return true;
+
+        if (wait_strategy == scq::wait_strategy::block || wait.expired())
+            return false;
+
+        lock.unlock();
+
+        bool const ready = detail::spin_until(wait_strategy,
+                                              wait,
+                                              [&lock, &predicate, &hint]
+                                              {
+                                                  if (!hint())
+                                                      return false;
+
+                                                  lock.lock();
+
+                                                  if (predicate())
+                                                      return true;
+
+                                                  lock.unlock();
+                                                  return false;
+                                              });
+
+        if (!ready)
+            lock.lock();
+
+        return ready;
+    }
+
+    static queue_op_status would_block_on_timeout(queue_op_status status)
+    {
+        return status == queue_op_status::timeout ? queue_op_status::would_block : status;
+    }
+
+    template <typename iterator_t>
+    static constexpr bool is_nothrow_constructible_from_iterator =
+        std::is_nothrow_constructible_v<value_type, std::iter_reference_t<iterator_t>>
+        && noexcept(*std::declval<iterator_t &>()) && noexcept(++std::declval<iterator_t &>());
+
+    template <typename wait_t, typename... args_t>
+    queue_op_status enqueue_with(slot_id slot, wait_t const & wait, args_t &&... args)
+    {
+        if constexpr (std::is_nothrow_constructible_v<value_type, args_t...>)
+        {
+            return construct_in_slot_cart(slot, wait, std::forward<args_t>(args)...);
+        }
+        else
+        {
+            // a reserved position must hold an element, i.e. the element is constructed before reserving a position
+            static_assert(std::is_nothrow_move_constructible_v<value_type>,
+                          "The value_type must be nothrow move constructible if its construction might throw.");
+
+            value_type value(std::forward<args_t>(args)...);
+            return construct_in_slot_cart(slot, wait, std::move(value));
+        }
+    }
+
+    // Reserves a position in the cart of the slot and constructs the element in place. The construction must not
+    // throw.
+    template <typename wait_t, typename... args_t>
+    queue_op_status construct_in_slot_cart(slot_id slot, wait_t const & wait, args_t &&... args)
+    {
+        static_assert(std::is_nothrow_constructible_v<value_type, args_t...>);
+
+        queue_op_status status{};
+
+        do
+        {
+            // lock-free: reserves a position in the current cart of the slot
+            if (auto reservation = cart_slots.reserve(slot, 1u); reservation.count > 0u)
+            {
+                std::construct_at(reserved_memory_region(reservation).data(), std::forward<args_t>(args)...);
+                commit(slot, reservation);
+                return queue_op_status::ok;
+            }
+        }
+        while ((status = wait_for_slot_cart(slot, wait)) == queue_op_status::ok); // the cart is full, set a new one
+
+        return status;
+    }
+
+    // Reserves the positions for as many of the count elements as fit into the current cart of the slot at once and
+    // constructs them via construct(memory_region), which must not throw.
+    // Returns the number of enqueued elements, which is less than count if the queue was closed.
+    template <typename construct_t>
+    size_t enqueue_n(slot_id slot, size_t count, construct_t && construct)
+    {
+        size_t enqueued_count{};
+
+        while (enqueued_count < count)
+        {
+            auto reservation = cart_slots.reserve(slot, std::min(count - enqueued_count, cart_capacity));
+
+            if (reservation.count == 0u)
+            {
+                // the cart of the slot is full, set a new one
+                if (wait_for_slot_cart(slot, wait_indefinitely{}) != queue_op_status::ok)
+                    break;
+
+                continue;
+            }
+
+            construct(reserved_memory_region(reservation));
+            commit(slot, reservation);
+
+            enqueued_count += reservation.count;
+        }
+
+        return enqueued_count;
+    }
+
+    // Enqueues the values of each slot, which are at [slot_offsets[slot_id], slot_offsets[slot_id + 1]) of the
+    // partitioned batch, with the construct function returned by make_construct(slot_offsets[slot_id]).
+    // Returns the number of enqueued elements, which is less than the size of the batch if the queue was closed.
+    template <typename make_construct_t>
+    size_t enqueue_partitions(std::span<size_t const> slot_offsets, make_construct_t && make_construct)
+    {
+        size_t enqueued_count{};
+
+        for (size_t slot_id = 0u; slot_id < slot_count; ++slot_id)
+        {
+            size_t const count = slot_offsets[slot_id + 1u] - slot_offsets[slot_id];
+
+            if (count == 0u)
+                continue;
+
+            size_t const slot_enqueued_count =
+                enqueue_n(scq::slot_id{slot_id}, count, make_construct(slot_offsets[slot_id]));
+            enqueued_count += slot_enqueued_count;
+
+            if (slot_enqueued_count < count) // the queue was closed
+                break;
+        }
+
+        return enqueued_count;
+    }
+
+    // enqueue_scatter for 8-byte integers: The batch is partitioned into a buffer by the SIMD kernels, such that the
+    // values of each slot are copied into a cart with one memcpy.
+    size_t enqueue_scatter_simd(std::span<slot_id const> slots, std::span<value_type const> values)
+        requires detail::partitionable_value<value_type>
+    {
+        detail::partition_kernels<value_type> const & kernels = detail::select_partition_kernels<value_type>();
+
+        // the kernels work on plain slot ids; slot_id objects must not be read through a size_t pointer
+        std::vector<size_t> slot_ids(slots.size());
+        std::ranges::transform(slots, slot_ids.begin(), &slot_id::value);
+
+        assert(std::ranges::all_of(slot_ids,
+                                   [this](size_t slot_id)
+                                   {
+                                       return slot_id < slot_count;
+                                   }));
+
+        // counting pass: slot_offsets[slot_id + 1] is the number of values of the slot
+        std::vector<size_t> slot_offsets(slot_count + 1u);
+        kernels.count_slots(slot_ids.data(), slot_ids.size(), slot_offsets.data() + 1);
+
+        // prefix sum: the values of a slot are at [slot_offsets[slot_id], slot_offsets[slot_id + 1])
+        std::inclusive_scan(slot_offsets.begin(), slot_offsets.end(), slot_offsets.begin());
+
+        std::vector<value_type> partitioned_values(values.size());
+        kernels.partition_values(slot_ids.data(),
+                                 values.data(),
+                                 values.size(),
+                                 slot_offsets.data(),
+                                 slot_count,
+                                 partitioned_values.data());
+
+        return enqueue_partitions(slot_offsets,
+                                  [&partitioned_values](size_t begin)
+                                  {
+                                      return [it = partitioned_values.data() + begin](
+                                                 std::span<value_type> memory_region) mutable noexcept
+                                      {
+                                          std::memcpy(memory_region.data(), it, memory_region.size_bytes());
+                                          it += memory_region.size();
+                                      };
+                                  });
+    }
+
+    template <typename wait_t>
+    queue_op_status dequeue_with(cart_future_type & cart_future, size_t partition, wait_t const & wait)
+    {
+        typename full_carts_queue_t::full_cart_type full_cart{};
+
+        queue_op_status status = full_carts_queue.dequeue(full_cart, partition, wait);
+
+        if (status == queue_op_status::ok)
+            cart_future = make_cart_future(full_cart);
+
+        return status;
+    }
+
+    cart_batch_type dequeue_batch_of(size_t max_count, size_t partition)
+    {
+        if (max_count == 0u)
+            throw std::logic_error{"The batch must comprise at least one cart."};
+
+        cart_batch_type cart_batch{};
+        cart_batch.full_carts.reserve(std::min(max_count, cart_count));
+
+        if (full_carts_queue.dequeue_n(cart_batch.full_carts, max_count, partition, wait_indefinitely{})
+            == queue_op_status::ok)
+            cart_batch.cart_queue = this;
+
+        return cart_batch;
+    }
+
+    cart_batch_type dequeue_coalesced_of(size_t partition)
+    {
+        cart_batch_type cart_batch{};
+
+        if (full_carts_queue.dequeue_slot(cart_batch.full_carts, partition, wait_indefinitely{}) == queue_op_status::ok)
+            cart_batch.cart_queue = this;
+
+        return cart_batch;
+    }
+
+    std::span<value_t> reserved_memory_region(typename cart_slots_t::reservation_t const & reservation)
+    {
+        return queue_memory.memory_region(reservation.cart_id).subspan(reservation.position, reservation.count);
+    }
+
+    // The producer that commits the last element of a cart hands the cart over to the consumers.
+    void commit(slot_id slot, typename cart_slots_t::reservation_t const & reservation)
+    {
+        if (cart_slots.commit(reservation))
+            publish_cart(slot, reservation.cart_id);
+    }
+
+    void publish_cart(slot_id slot, cart_memory_id cart_id)
+    {
+        size_t const size = cart_slots.cart_size(cart_id);
+
+        if (size > 0u)
+            full_carts_queue.enqueue(cart_id, {slot, queue_memory.memory_region(cart_id).first(size)});
+        else // a sealed cart without elements
+            empty_carts_queue.enqueue(cart_id);
+
+        cart_slots.notify_cart_published();
+    }
+
+    // Sets a new cart for the slot if its current cart is completely reserved. Only one producer per slot fetches an
+    // empty cart, the other producers of the slot wait until that cart was set. The slot lock is released while
+    // waiting, such that other slots of the same lock stripe are not blocked.
+    // Returns queue_op_status::ok if positions can be reserved in the cart of the slot.
+    template <typename wait_t>
+    queue_op_status wait_for_slot_cart(slot_id slot, wait_t const & wait)
+    {
+        std::unique_lock<std::mutex> slot_lock = cart_slots.lock(slot);
+
+        bool cart_set{false};
+        std::optional<cart_memory_id> unused_cart_id{};
+
+        while (!queue_closed && !cart_slots.has_free_positions(slot))
+        {
+            if (cart_slots.cart_requested(slot))
+            {
+                if (!cart_slots.wait_until_cart_set(slot_lock, slot, wait))
+                    return queue_op_status::timeout;
+
+                continue;
+            }
+
+            cart_slots.set_cart_requested(slot, true);
+            slot_lock.unlock();
+            std::optional<cart_memory_id> cart_id = empty_carts_queue.dequeue(wait); // might block
+            slot_lock.lock();
+            cart_slots.set_cart_requested(slot, false);
+
+            // cart_id is empty if the queue was closed or the wait timed out
+            if (cart_id.has_value() && !queue_closed)
+            {
+                cart_slots.set_cart(slot, *cart_id);
+                cart_set = true;
+            }
+            else if (cart_id.has_value())
+            {
+                unused_cart_id = cart_id;
+            }
+
+            cart_slots.notify_all(slot);
+
+            if (!cart_id.has_value() && !queue_closed)
+                return queue_op_status::timeout;
+        }
+
+        queue_op_status const status = queue_closed ? queue_op_status::closed : queue_op_status::ok;
+        slot_lock.unlock();
+
+        // the async producers retry to enqueue when they are woken up, i.e. the slot lock must not be held
+        if (unused_cart_id.has_value())
+            empty_carts_queue.enqueue(*unused_cart_id);
+
+        if (cart_set)
+            empty_carts_queue.notify_cart_set();
+
+        return status;
+    }
+
+    // read by each enqueue, apart from the cart slots and the hot state of the carts queues
+    alignas(std::hardware_destructive_interference_size) std::atomic_bool queue_closed{false};
+
+    cart_slots_t cart_slots{scq::slots{slot_count},
+                            scq::carts{cart_count},
+                            scq::capacity{cart_capacity},
+                            scq::lock_stripes{lock_stripe_count},
+                            queue_closed,
+                            memory_resource};
+
+    std::pmr::vector<std::thread> consumer_threads{memory_resource}; // see start_consumers
+    std::mutex consumer_exception_mutex;
+    std::exception_ptr consumer_exception{};
+};
+
+template <typename value_t>
+template <coroutine_executor executor_t>
+class slotted_cart_queue<value_t>::dequeue_awaiter : private async_dequeue_waiter_t
+{
+public:
+    dequeue_awaiter(dequeue_awaiter const &) = delete;
+    dequeue_awaiter & operator=(dequeue_awaiter const &) = delete;
+
+    bool await_ready()
+    {
+        return cart_queue.try_dequeue(cart_future) != queue_op_status::would_block;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        coroutine = handle;
+        this->wake = &resume_on_executor;
+
+        return cart_queue.full_carts_queue.suspend_dequeue(*this);
+    }
+
+    cart_future_type await_resume()
+    {
+        if (this->status == queue_op_status::ok)
+            cart_future = cart_queue.make_cart_future(this->full_cart);
+
+        return std::move(cart_future);
+    }
+
+private:
+    friend slotted_cart_queue;
+
+    dequeue_awaiter(slotted_cart_queue & cart_queue, executor_t executor) :
+        cart_queue{cart_queue},
+        executor{std::move(executor)}
+    {}
+
+    // the waiter was handed a full cart or the queue was drained
+    static void resume_on_executor(async_waiter_t & waiter)
+    {
+        dequeue_awaiter & awaiter = static_cast<dequeue_awaiter &>(waiter);
+
+        // the coroutine might be resumed before the executor returns, i.e. the awaiter must not be accessed by it
+        executor_t executor = awaiter.executor;
+        executor(awaiter.coroutine);
+    }
+
+    slotted_cart_queue & cart_queue;
+    executor_t executor;
+    std::coroutine_handle<> coroutine{};
+    cart_future_type cart_future{};
+};
+
+template <typename value_t>
+template <coroutine_executor executor_t>
+class slotted_cart_queue<value_t>::enqueue_awaiter : private async_waiter_t
+{
+public:
+    enqueue_awaiter(enqueue_awaiter const &) = delete;
+    enqueue_awaiter & operator=(enqueue_awaiter const &) = delete;
+
+    bool await_ready()
+    {
+        return try_enqueue();
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        coroutine = handle;
+        this->wake = &retry_enqueue;
+
+        // once suspended, the awaiter might be resumed by another thread, i.e. it must not be accessed anymore
+        return suspend_or_enqueue();
+    }
+
+    queue_op_status await_resume() const
+    {
+        return status;
+    }
+
+private:
+    friend slotted_cart_queue;
+
+    enqueue_awaiter(slotted_cart_queue & cart_queue, slot_id slot, value_type && value, executor_t executor) :
+        cart_queue{cart_queue},
+        slot{slot},
+        value{std::move(value)},
+        executor{std::move(executor)}
+    {}
+
+    // Returns true if the value was enqueued or the queue was closed. The value is only moved from if it was enqueued.
+    bool try_enqueue()
+    {
+        epoch = cart_queue.empty_carts_queue.async_epoch();
+        status = cart_queue.try_enqueue(slot, std::move(value));
+        return status != queue_op_status::would_block;
+    }
+
+    // Returns false if the value was enqueued or the queue was closed before the awaiter could be suspended.
+    bool suspend_or_enqueue()
+    {
+        while (!cart_queue.empty_carts_queue.suspend_unless_notified(*this, epoch))
+        {
+            if (try_enqueue())
+                return false;
+        }
+
+        return true;
+    }
+
+    // an empty cart was returned, a cart was set for some slot or the queue was closed
+    static void retry_enqueue(async_waiter_t & waiter)
+    {
+        enqueue_awaiter & awaiter = static_cast<enqueue_awaiter &>(waiter);
+
+        if (awaiter.try_enqueue() || !awaiter.suspend_or_enqueue())
+        {
+            // the coroutine might be resumed before the executor returns, i.e. the awaiter must not be accessed by it
+            executor_t executor = awaiter.executor;
+            executor(awaiter.coroutine);
+        }
+    }
+
+    slotted_cart_queue & cart_queue;
+    slot_id slot;
+    value_type value;
+    executor_t executor;
+    std::coroutine_handle<> coroutine{};
+    queue_op_status status{queue_op_status::would_block};
+    size_t epoch{};
+};
+
+// The queue memory is uninitialised storage. Elements are constructed when they are enqueued and destroyed when the
+// cart was processed.
+// Each cart starts on a cache line of its own, such that the producers of neighbouring carts do not interfere; the
+// carts are cart_stride bytes apart.
+template <typename value_t>
+struct slotted_cart_queue<value_t>::queue_memory_t
+{
+    static constexpr size_t cart_alignment{std::max(std::hardware_destructive_interference_size, alignof(value_t))};
+
+    queue_memory_t() = default;
+    queue_memory_t(queue_memory_t const &) = delete;
+    queue_memory_t & operator=(queue_memory_t const &) = delete;
+    queue_memory_t(scq::carts carts, scq::capacity capacity, std::pmr::memory_resource * resource, bool huge_pages) :
+        cart_capacity{capacity.value},
+        cart_stride{(capacity.value * sizeof(value_t) + cart_alignment - 1u) / cart_alignment * cart_alignment},
+        size{carts.value * cart_stride},
+        allocator{resource}
+    {
+        if (huge_pages)
+            mapping = detail::map_huge_pages(size);
+
+        void * memory = mapping.data != nullptr ? mapping.data : allocator.allocate_bytes(size, cart_alignment);
+        internal_queue_memory = static_cast<std::byte *>(memory);
+    }
+
+    ~queue_memory_t()
+    {
+        if (mapping.data != nullptr)
+            detail::unmap_huge_pages(mapping);
+        else if (internal_queue_memory != nullptr)
+            allocator.deallocate_bytes(internal_queue_memory, size, cart_alignment);
+    }
+
+    std::span<value_t> memory_region(cart_memory_id cart_memory_id)
+    {
+        return {reinterpret_cast<value_t *>(internal_queue_memory + cart_memory_id.value * cart_stride), cart_capacity};
+    }
+
+    cart_memory_id cart_id(std::span<value_t> memory_region)
+    {
+        return {offset(memory_region) / cart_stride};
+    }
+
+    // the position of the memory region within its cart
+    size_t position(std::span<value_t> memory_region)
+    {
+        return offset(memory_region) % cart_stride / sizeof(value_t);
+    }
+
+    // the byte offset of the memory region within the queue memory
+    size_t offset(std::span<value_t> memory_region)
+    {
+        return static_cast<size_t>(reinterpret_cast<std::byte *>(memory_region.data()) - internal_queue_memory);
+    }
+
+    size_t cart_capacity{};
+    size_t cart_stride{}; // in bytes
+    size_t size{};        // in bytes
+
+    std::pmr::polymorphic_allocator<> allocator{};
+    detail::huge_page_mapping mapping{}; // params::huge_pages: the mapping that holds the cart memory
+    std::byte * internal_queue_memory{nullptr};
+};
+
+// Producers fill the cart of a slot without locking: A slot stores its current cart and the number of reserved
+// positions within one atomic word. A producer reserves positions via fetch_add, writes its elements and commits them.
+// The producer that commits the last position of a cart publishes the cart. The lock of a slot is only needed to set
+// a new cart once all positions of the current cart were reserved, and to seal a cart when the queue is closed.
+template <typename value_t>
 struct slotted_cart_queue<value_t>::cart_slots_t
 {
+    using slot_state_t = uint64_t;
+
+    static constexpr size_t position_bits{32u};
+    static constexpr slot_state_t position_mask{(slot_state_t{1u} << position_bits) - 1u};
+    static constexpr size_t no_cart{position_mask};
+    static constexpr slot_state_t no_cart_state{slot_state_t{no_cart} << position_bits};
+
+    static constexpr size_t max_cart_count{no_cart - 1u};
+    // Producers might reserve single positions beyond the capacity of a cart before a new cart is set (see reserve);
+    // the remaining bits absorb this.
+    static constexpr size_t max_cart_capacity{size_t{1u} << (position_bits - 1u)};
+    // Each thread overshoots at most once per cart, and there are fewer threads than Linux' PID_MAX_LIMIT (2^22).
+    static_assert(max_cart_capacity - 1u + (size_t{1u} << 22) <= position_mask,
+                  "The overshooting reservations must not overflow into the cart id.");
+
     cart_slots_t() = default;
-    cart_slots_t(scq::slots slots, scq::capacity capacity) :
+    cart_slots_t(scq::slots slots,
+                 scq::carts carts,
+                 scq::capacity capacity,
+                 scq::lock_stripes lock_stripes,
+                 std::atomic_bool const & queue_closed,
+                 std::pmr::memory_resource * resource) :
+        queue_closed{&queue_closed},
         cart_capacity{capacity.value},
-        internal_cart_slots(slots.value) // default init slots many vectors
+        internal_cart_slots(slots.value, resource), // default init slots many slots
+        cart_fill_states(carts.value, resource),
+        lock_stripes(lock_stripes.value, resource)
     {}
 
-    struct slot_cart_t
+    // Each slot and each fill state resides on its own cache line, such that the producers of different slots (and
+    // carts) do not interfere.
+    struct alignas(std::hardware_destructive_interference_size) internal_slot_t
+    {
+        std::atomic<slot_state_t> state{no_cart_state}; // current cart and number of reserved positions
+        bool cart_requested{false};                      // whether a producer of this slot waits for an empty cart
+    };
+
+    struct alignas(std::hardware_destructive_interference_size) cart_fill_state_t
+    {
+        std::atomic<size_t> committed_count{0u}; // the cart is complete if committed_count reaches cart_capacity
+        size_t size{0u};                          // cart_capacity unless the cart was sealed
+    };
+
+    // count many positions starting at position within the cart cart_id
+    struct reservation_t
+    {
+        cart_memory_id cart_id{};
+        size_t position{};
+        size_t count{};
+    };
+
+    static slot_state_t make_state(size_t cart_id, size_t position)
+    {
+        return (slot_state_t{cart_id} << position_bits) | position;
+    }
+
+    static size_t cart_of(slot_state_t state)
+    {
+        return state >> position_bits;
+    }
+
+    static size_t position_of(slot_state_t state)
+    {
+        return state & position_mask;
+    }
+
+    // Reserves up to count positions in the current cart of the slot. Returns a reservation of 0 positions if the
+    // slot has no cart or all positions of the cart are reserved.
+    reservation_t reserve(scq::slot_id slot_id, size_t count)
+    {
+        assert(count > 0u);
+        assert(count <= cart_capacity);
+
+        std::atomic<slot_state_t> & state = internal_cart_slots[slot_id.value].state;
+
+        // do not overshoot the reservations if the cart is known to be full
+        slot_state_t current_state = state.load(std::memory_order_relaxed);
+        if (cart_of(current_state) == no_cart || position_of(current_state) >= cart_capacity)
+            return {};
+
+        if (count == 1u)
+        {
+            // A single position is reserved via fetch_add, which might overshoot the capacity if the cart became full
+            // in the meantime. Since the position is checked before, each thread overshoots at most once per cart.
+            // acquire: the cart was set by set_cart
+            current_state = state.fetch_add(1u, std::memory_order_acq_rel);
+        }
+        else
+        {
+            // More positions are reserved via compare-exchange, which never reserves beyond the capacity; otherwise
+            // concurrent producers could overshoot by up to cart_capacity each.
+            // acquire: the cart was set by set_cart
+            do
+            {
+                if (cart_of(current_state) == no_cart || position_of(current_state) >= cart_capacity)
+                    return {};
+            }
+            while (!state.compare_exchange_weak(current_state,
+                                                current_state
+                                                    + std::min(count, cart_capacity - position_of(current_state)),
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_relaxed));
+        }
+
+        size_t const cart_id = cart_of(current_state);
+        size_t const position = position_of(current_state);
+
+        if (cart_id == no_cart || position >= cart_capacity)
+            return {};
+
+        return {cart_memory_id{cart_id}, position, std::min(count, cart_capacity - position)};
+    }
+
+    // Returns true if the reservation completed the cart, i.e. the caller has to publish the cart.
+    bool commit(reservation_t const & reservation)
+    {
+        // acq_rel: the publisher needs to see the elements of all producers that committed to this cart
+        size_t const committed_count =
+            cart_fill_states[reservation.cart_id.value].committed_count.fetch_add(reservation.count,
+                                                                                   std::memory_order_acq_rel);
+        return committed_count + reservation.count == cart_capacity;
+    }
+
+    // Detaches the cart from the slot and reserves up to count positions in it, such that no other producer can reserve
+    // positions until the cart is reattached. Returns a reservation of 0 positions if the slot has no cart or all
+    // positions of the cart are reserved. Expects the slot lock to be locked.
+    reservation_t detach(scq::slot_id slot_id, size_t count)
+    {
+        slot_state_t const state =
+            internal_cart_slots[slot_id.value].state.exchange(no_cart_state, std::memory_order_acq_rel);
+
+        size_t const cart_id = cart_of(state);
+        size_t const position = position_of(state);
+
+        if (cart_id == no_cart || position >= cart_capacity)
+            return {};
+
+        return {cart_memory_id{cart_id}, position, std::min(count, cart_capacity - position)};
+    }
+
+    // Reattaches a detached cart to the slot, such that producers continue to reserve behind the committed positions.
+    // If the queue was closed in the meantime, the cart is sealed instead.
+    // Returns the positions the caller has to commit. Expects the slot lock to be locked.
+    reservation_t reattach(scq::slot_id slot_id, reservation_t const & committed, bool queue_closed)
+    {
+        size_t const reserved_count = committed.position + committed.count;
+
+        if (!queue_closed && reserved_count < cart_capacity)
+        {
+            internal_cart_slots[slot_id.value].state.store(make_state(committed.cart_id.value, reserved_count),
+                                                           std::memory_order_release);
+            return committed;
+        }
+
+        // the cart is completely reserved or sealed; mark all unreserved positions as committed
+        cart_fill_states[committed.cart_id.value].size = reserved_count;
+        return {committed.cart_id, committed.position, cart_capacity - committed.position};
+    }
+
+    // Detaches the cart from the slot, such that no further positions can be reserved.
+    // Returns the cart if it needs to be published by the caller, i.e. if all reserved positions were committed.
+    // Expects the queue to be closed.
+    std::optional<cart_memory_id> seal(scq::slot_id slot_id)
+    {
+        std::unique_lock<std::mutex> slot_lock = lock(slot_id);
+
+        slot_state_t const state =
+            internal_cart_slots[slot_id.value].state.exchange(no_cart_state, std::memory_order_acq_rel);
+
+        size_t const cart_id = cart_of(state);
+        size_t const reserved_count = std::min<size_t>(position_of(state), cart_capacity);
+
+        // a completely reserved cart is published by the producer that commits last
+        if (cart_id == no_cart || reserved_count == cart_capacity)
+            return std::nullopt;
+
+        cart_fill_state_t & cart_fill_state = cart_fill_states[cart_id];
+        cart_fill_state.size = reserved_count;
+
+        // mark all unreserved positions as committed
+        size_t const unreserved_count = cart_capacity - reserved_count;
+        size_t const committed_count =
+            cart_fill_state.committed_count.fetch_add(unreserved_count, std::memory_order_acq_rel);
+
+        if (committed_count + unreserved_count == cart_capacity)
+            return cart_memory_id{cart_id};
+
+        return std::nullopt;
+    }
+
+    size_t cart_size(cart_memory_id cart_id)
+    {
+        return cart_fill_states[cart_id.value].size;
+    }
+
+    // Whether positions can be reserved in the current cart of the slot. Expects the slot lock to be locked.
+    bool has_free_positions(scq::slot_id slot_id)
+    {
+        slot_state_t const state = internal_cart_slots[slot_id.value].state.load(std::memory_order_acquire);
+        return cart_of(state) != no_cart && position_of(state) < cart_capacity;
+    }
+
+    // Replaces the completely reserved cart of the slot. Expects the slot lock to be locked.
+    void set_cart(scq::slot_id slot_id, cart_memory_id cart_id)
+    {
+        assert(!has_free_positions(slot_id));
+
+        cart_fill_state_t & cart_fill_state = cart_fill_states[cart_id.value];
+        cart_fill_state.committed_count.store(0u, std::memory_order_relaxed);
+        cart_fill_state.size = cart_capacity;
+
+        active_cart_count.fetch_add(1u);
+
+        // release: producers that reserve a position in the new cart see the reset cart_fill_state
+        internal_cart_slots[slot_id.value].state.store(make_state(cart_id.value, 0u), std::memory_order_release);
+    }
+
+    // The flag is read after the decrement: close() sets it before it reads the count, so either close() sees the
+    // decremented count or the producer that published the last cart sees the flag and wakes it up.
+    void notify_cart_published()
+    {
+        if (active_cart_count.fetch_sub(1u) == 1u && queue_closed->load())
+            active_cart_count.notify_all();
+    }
+
+    // Expects all carts to be sealed.
+    void wait_until_all_carts_published()
+    {
+        for (size_t count = active_cart_count.load(); count != 0u; count = active_cart_count.load())
+            active_cart_count.wait(count);
+    }
+
+    bool cart_requested(scq::slot_id slot_id)
+    {
+        return internal_cart_slots[slot_id.value].cart_requested;
+    }
+
+    void set_cart_requested(scq::slot_id slot_id, bool cart_requested)
+    {
+        internal_cart_slots[slot_id.value].cart_requested = cart_requested;
+    }
+
+    std::unique_lock<std::mutex> lock(scq::slot_id slot_id)
+    {
+        return std::unique_lock<std::mutex>{lock_stripe(slot_id).mutex};
+    }
+
+    // Waits until the producer that requested a cart for the slot is done. Returns false if the wait gave up.
+    template <typename wait_t>
+    bool wait_until_cart_set(std::unique_lock<std::mutex> & slot_lock, scq::slot_id slot_id, wait_t const & wait)
+    {
+        return wait(lock_stripe(slot_id).cart_requested_cv,
+                    slot_lock,
+                    [this, slot_id]
+                    {
+                        return !cart_requested(slot_id);
+                    });
+    }
+
+    void notify_all(scq::slot_id slot_id)
+    {
+        lock_stripe(slot_id).cart_requested_cv.notify_all();
+    }
+
+    // Each lock resides on its own cache line, such that threads working on different stripes do not interfere.
+    struct alignas(std::hardware_destructive_interference_size) lock_stripe_t
+    {
+        std::mutex mutex;
+        std::condition_variable cart_requested_cv;
+    };
+
+    lock_stripe_t & lock_stripe(scq::slot_id slot_id)
+    {
+        return lock_stripes[slot_id.value % lock_stripes.size()];
+    }
+
+    std::atomic_bool const * queue_closed{nullptr}; // the closed flag of the queue
+    size_t cart_capacity{};
+
+    std::pmr::vector<internal_slot_t> internal_cart_slots{}; // position is slot_id
+    std::pmr::vector<cart_fill_state_t> cart_fill_states{};  // position is cart_memory_id
+    std::pmr::vector<lock_stripe_t> lock_stripes{};          // position is slot_id % lock_stripes.size()
+
+    // number of carts that were set for a slot but not yet published
+    alignas(std::hardware_destructive_interference_size) std::atomic<size_t> active_cart_count{0u};
+};
+
+// The empty carts are kept in a lock-free stack of cart ids (see detail::cart_id_stack).
+// Consumers return their carts without taking a lock; the mutex is only taken by producers that have to wait for an
+// empty cart and, if some producer is waiting, by the consumer that wakes it up.
+// With numa_aware, each NUMA node has a pool of a contiguous range of carts; a cart always returns to its pool and
+// producers take from the pool of the node they run on first.
+template <typename value_t>
+struct slotted_cart_queue<value_t>::empty_carts_queue_t
+{
+    empty_carts_queue_t() = default;
+    empty_carts_queue_t(carts carts,
+                        scq::wait_strategy wait_strategy,
+                        std::pmr::memory_resource * resource,
+                        detail::numa_topology const * numa_topology) :
+        wait_strategy{wait_strategy},
+        numa_topology{numa_topology},
+        pool_size{std::max<size_t>(1u, (carts.value + pool_count() - 1u) / pool_count())},
+        empty_carts{carts.value, pool_count(), resource}
+    {
+        for (size_t i = 0u; i < carts.value; ++i)
+            empty_carts.push(i, pool_of(i));
+    }
+
+    size_t pool_count() const
+    {
+        return numa_topology != nullptr ? numa_topology->node_count() : 1u;
+    }
+
+    size_t pool_of(size_t cart_id) const
+    {
+        return cart_id / pool_size;
+    }
+
+    // The carts [first, last) of the pool.
+    std::pair<size_t, size_t> pool_carts(size_t pool) const
+    {
+        size_t const cart_count = empty_carts.next_ids.size();
+        return {std::min(pool * pool_size, cart_count), std::min((pool + 1u) * pool_size, cart_count)};
+    }
+
+    void enqueue(cart_memory_id cart_id)
+    {
+        empty_carts.push(cart_id.value, pool_of(cart_id.value));
+        notify_waiters(1u);
+    }
+
+    // Enqueues all carts of the range with a single compare-exchange (a single pool), or one by one into their pools.
+    template <std::ranges::input_range range_t>
+    void enqueue_range(range_t && cart_ids)
+    {
+        size_t pushed_count{};
+
+        if (pool_count() == 1u)
+        {
+            pushed_count = empty_carts.push_range(cart_ids
+                                                  | std::views::transform(
+                                                      [](cart_memory_id cart_id)
+                                                      {
+                                                          return cart_id.value;
+                                                      }));
+        }
+        else
+        {
+            for (cart_memory_id cart_id : cart_ids)
+            {
+                empty_carts.push(cart_id.value, pool_of(cart_id.value));
+                ++pushed_count;
+            }
+        }
+
+        if (pushed_count > 0u)
+            notify_waiters(pushed_count);
+    }
+
+    // A cart was set for some slot, i.e. async producers that wait for the slot's cart can retry.
+    void notify_cart_set()
+    {
+        notify_waiters(0u);
+    }
+
+    // The number of events that allowed async producers to retry; a producer that failed to enqueue only suspends if
+    // no such event happened since it read this number before its attempt.
+    size_t async_epoch()
+    {
+        return internal_async_epoch.load(std::memory_order_seq_cst);
+    }
+
+    // Returns false if the producer has to retry instead, i.e. the async_epoch changed.
+    bool suspend_unless_notified(async_waiter_t & waiter, size_t epoch)
+    {
+        std::unique_lock<std::mutex> empty_cart_queue_lock(empty_cart_queue_mutex);
+
+        // the waiter is registered before the epoch is checked, i.e. either the notifying thread sees the waiter or
+        // the waiter sees the new epoch
+        waiter_count.fetch_add(1u, std::memory_order_seq_cst);
+
+        if (internal_async_epoch.load(std::memory_order_seq_cst) != epoch)
+        {
+            waiter_count.fetch_sub(1u, std::memory_order_relaxed);
+            return false;
+        }
+
+        async_enqueue_waiters.push_back(waiter);
+        return true;
+    }
+
+    // Blocks until an empty cart is available. Returns no cart if the queue was closed or the wait gave up.
+    template <typename wait_t>
+    std::optional<cart_memory_id> dequeue(wait_t const & wait)
+    {
+        if (closed)
+            return std::nullopt;
+
+        std::optional<cart_memory_id> cart_id = pop();
+
+        if (cart_id.has_value())
+            return cart_id;
+
+        // the stack is lock-free, i.e. spinning threads do not need to take the lock
+        if (detail::spin_until(wait_strategy,
+                               wait,
+                               [this, &cart_id]
+                               {
+                                   return closed || (cart_id = pop()).has_value();
+                               }))
+            return cart_id; // no cart if the queue was closed
+
+        std::unique_lock<std::mutex> empty_cart_queue_lock(empty_cart_queue_mutex);
+
+        // the waiter is registered before the stack is checked, i.e. either the notifying thread sees the waiter or
+        // the waiter sees the pushed cart
+        waiter_count.fetch_add(1u, std::memory_order_seq_cst);
+        ++blocked_count;
+
+        bool const ready = wait(empty_cart_queue_empty_or_closed_cv,
+                                empty_cart_queue_lock,
+                                [this, &cart_id]
+                                {
+                                    // wait until either an empty cart is ready or the queue was closed
+                                    return closed || (cart_id = pop()).has_value();
+                                });
+
+        --blocked_count;
+        waiter_count.fetch_sub(1u, std::memory_order_relaxed);
+
+        // each cart woke up a single producer, which might not have been the one that took it
+        bool const pass_on = cart_id.has_value() && blocked_count > 0u && !empty_carts.empty();
+        empty_cart_queue_lock.unlock();
+
+        if (pass_on)
+            empty_cart_queue_empty_or_closed_cv.notify_one();
+
+        if (!ready)
+            return std::nullopt;
+
+        return cart_id; // no cart if the queue was closed
+    }
+
+    void close()
+    {
+        async_waiter_list_t woken_waiters{};
+
+        {
+            std::unique_lock<std::mutex> empty_cart_queue_lock(empty_cart_queue_mutex);
+            closed = true;
+            woken_waiters = take_async_waiters();
+        }
+
+        empty_cart_queue_empty_or_closed_cv.notify_all();
+
+        std::move(woken_waiters).wake_all();
+    }
+
+    std::optional<cart_memory_id> pop()
+    {
+        size_t const preferred_pool = numa_topology != nullptr ? numa_topology->current_node() : 0u;
+
+        if (std::optional<size_t> cart_id = empty_carts.pop(preferred_pool); cart_id.has_value())
+            return cart_memory_id{*cart_id};
+
+        return std::nullopt;
+    }
+
+    // Wakes up one blocked producer per pushed cart and all suspended producers, which retry on the notifying thread
+    // since they might also wait for the cart of their slot. The lock is only taken if there are any waiters.
+    void notify_waiters(size_t pushed_count)
+    {
+        internal_async_epoch.fetch_add(1u, std::memory_order_seq_cst);
+
+        if (waiter_count.load(std::memory_order_seq_cst) == 0u)
+            return;
+
+        async_waiter_list_t woken_waiters{};
+        size_t woken_count{};
+
+        {
+            std::unique_lock<std::mutex> empty_cart_queue_lock(empty_cart_queue_mutex);
+            woken_waiters = take_async_waiters();
+            woken_count = std::min(pushed_count, blocked_count);
+        }
+
+        for (size_t i = 0u; i < woken_count; ++i)
+            empty_cart_queue_empty_or_closed_cv.notify_one();
+
+        std::move(woken_waiters).wake_all();
+    }
+
+    // Expects the lock to be locked.
+    async_waiter_list_t take_async_waiters()
+    {
+        internal_async_epoch.fetch_add(1u, std::memory_order_seq_cst);
+
+        for (async_waiter_t * waiter = async_enqueue_waiters.first; waiter != nullptr; waiter = waiter->next)
+            waiter_count.fetch_sub(1u, std::memory_order_relaxed);
+
+        return std::exchange(async_enqueue_waiters, async_waiter_list_t{});
+    }
+
+    scq::wait_strategy wait_strategy{};
+    detail::numa_topology const * numa_topology{nullptr}; // numa_aware: the nodes of the pools
+    size_t pool_size{1u};                                 // number of carts per pool
+
+    detail::cart_id_stack empty_carts{}; // the ids of the empty carts, one pool per node
+
+    std::atomic_bool closed{false};
+
+    // The groups of hot members below reside on cache lines of their own, apart from the read-mostly members above:
+    // the waiter count and the epoch are read whenever a cart is returned, the mutex is only taken by waiting producers
+    // and by the threads that wake them up.
+
+    // number of blocked producers plus the number of suspended async producers
+    alignas(std::hardware_destructive_interference_size) std::atomic<size_t> waiter_count{0u};
+    std::atomic<size_t> internal_async_epoch{0u};
+
+    alignas(std::hardware_destructive_interference_size) std::mutex empty_cart_queue_mutex;
+    size_t blocked_count{}; // number of blocked producers, protected by the mutex
+    async_waiter_list_t async_enqueue_waiters{};
+    std::condition_variable empty_cart_queue_empty_or_closed_cv;
+};
+
+// The full carts are stored by their cart_memory_id. Each partition keeps the order in which its carts are handed out
+// as an intrusive list of cart ids (lifo, fifo) or as one list of cart ids per slot plus the list of its slots with
+// full carts (round_robin). Consumers of any partition take the carts of the partitions in turn.
+// With exclusive slots, a slot has at most one cart that is either available or being processed; its further full
+// carts are held back in a list per slot until the slot is released.
+template <typename value_t>
+struct slotted_cart_queue<value_t>::full_carts_queue_t
+{
+    using full_cart_type = std::pair<slot_id, std::span<value_t>>;
+
+    static constexpr size_t no_id{std::numeric_limits<size_t>::max()};
+    static constexpr size_t any_partition{no_id};
+
+    full_carts_queue_t() = default;
+    full_carts_queue_t(slots slots,
+                       carts carts,
+                       scq::partitions partitions,
+                       scq::cart_order order,
+                       bool exclusive_slots,
+                       scq::wait_strategy wait_strategy,
+                       bool lock_free,
+                       std::pmr::memory_resource * resource) :
+        count{},
+        cart_count{carts.value},
+        slot_count{slots.value},
+        order{order},
+        exclusive_slots{exclusive_slots},
+        wait_strategy{wait_strategy},
+        full_carts(cart_count, resource),
+        next_carts(cart_count, no_id, resource),
+        internal_partitions(partitions.value, resource),
+        next_partitions(partitions.value, no_id, resource),
+        slot_queues(resource),
+        next_slots(resource),
+        exclusive_slot_states(resource),
+        full_carts_ring{lock_free ? carts.value : 0u, resource}
+    {
+        if (order == scq::cart_order::round_robin)
+        {
+            slot_queues.resize(slots.value);
+            next_slots.resize(slots.value, no_id);
+        }
+
+        if (exclusive_slots)
+            exclusive_slot_states.resize(slots.value);
+    }
+
+    size_t partition_of(slot_id slot) const
+    {
+        return slot.value * internal_partitions.size() / slot_count;
+    }
+
+    bool empty()
+    {
+        return count.value == 0;
+    }
+
+    bool empty(size_t partition)
+    {
+        return partition == any_partition ? empty() : internal_partitions[partition].count == 0u;
+    }
+
+    // Whether all carts of the partition (or of any partition) were handed out, including the held back carts.
+    bool drained(size_t partition)
+    {
+        if (partition == any_partition)
+            return empty() && held_count == 0u;
+
+        return empty(partition) && internal_partitions[partition].held_count == 0u;
+    }
+
+    void enqueue(cart_memory_id cart_id, full_cart_type full_cart)
     {
-        size_t _slot_id;
-        size_t cart_capacity;
-        std::span<value_t> * memory_region_ptr;
+        if (full_carts_ring.enabled())
+        {
+            full_carts[cart_id.value] = full_cart; // published by the push
+            full_carts_ring.push(cart_id.value);
+            notify_ring_waiters();
+            return;
+        }
+
+        size_t const partition = partition_of(full_cart.first);
+        consumer_wakeup_t wakeup{};
+        async_waiter_list_t woken_waiters{};
 
-        scq::slot_id slot_id() const
         {
-            return {_slot_id};
+            std::unique_lock<std::mutex> full_cart_queue_lock(full_cart_queue_mutex);
+
+            full_carts[cart_id.value] = full_cart;
+
+            if (exclusive_slots)
+            {
+                exclusive_slot_state_t & slot_state = exclusive_slot_states[full_cart.first.value];
+
+                if (std::exchange(slot_state.blocked, true)) // the slot has a cart that is available or processed
+                {
+                    slot_state.held_carts.push_back(next_carts, cart_id.value);
+                    ++internal_partitions[partition].held_count;
+                    ++held_count;
+                    return;
+                }
+            }
+
+            if (make_available(cart_id.value, partition, woken_waiters))
+                wakeup.cv = waiting_consumer(partition);
         }
 
-        size_t size() const
+        wake_up(wakeup);
+        std::move(woken_waiters).wake_all();
+    }
+
+    // Makes the next held back cart of each slot available, the slots without held back carts are unblocked.
+    // Consecutive repetitions of a slot release it once, i.e. the carts of a coalesced batch release their slot once.
+    template <std::ranges::input_range range_t>
+    void release_slots(range_t && slots)
+    {
+        consumer_wakeup_t wakeup{};
+        async_waiter_list_t woken_waiters{};
+
         {
-            return memory_region().size();
+            std::unique_lock<std::mutex> full_cart_queue_lock(full_cart_queue_mutex);
+
+            size_t previous_slot{no_id};
+            for (slot_id slot : slots)
+            {
+                if (std::exchange(previous_slot, slot.value) == slot.value)
+                    continue;
+
+                exclusive_slot_state_t & slot_state = exclusive_slot_states[slot.value];
+                assert(slot_state.blocked);
+
+                if (slot_state.held_carts.empty())
+                {
+                    slot_state.blocked = false;
+                    continue;
+                }
+
+                size_t const partition = partition_of(slot);
+                --internal_partitions[partition].held_count;
+                --held_count;
+
+                // several carts might become available, i.e. the consumers are notified while holding the lock
+                if (make_available(slot_state.held_carts.pop_front(next_carts), partition, woken_waiters))
+                {
+                    if (std::condition_variable * cv = waiting_consumer(partition); cv != nullptr)
+                        cv->notify_one();
+                }
+            }
+
+            take_async_waiters_if_drained(woken_waiters);
+
+            // the queue might be drained now
+            wakeup.all = closed;
         }
 
-        size_t capacity() const
+        wake_up(wakeup);
+        std::move(woken_waiters).wake_all();
+    }
+
+    // Hands the cart over to a suspended async consumer or appends it to the order of its partition. Returns false if
+    // the cart was handed over. Expects the lock to be locked.
+    bool make_available(size_t cart_id, size_t partition, async_waiter_list_t & woken_waiters)
+    {
+        full_cart_type const & full_cart = full_carts[cart_id];
+
+        if (!async_dequeue_waiters.empty())
         {
-            return cart_capacity;
+            auto & waiter = static_cast<async_dequeue_waiter_t &>(async_dequeue_waiters.pop_front());
+            waiter.full_cart = full_cart;
+            waiter.status = queue_op_status::ok;
+            woken_waiters.push_back(waiter);
+            return false;
         }
 
-        bool empty() const
+        ++count.value;
+        check_invariant();
+
+        partition_t & internal_partition = internal_partitions[partition];
+        ++internal_partition.count;
+
+        switch (order)
+        {
+        case scq::cart_order::lifo:
+            internal_partition.carts.push_front(next_carts, cart_id);
+            break;
+        case scq::cart_order::fifo:
+            internal_partition.carts.push_back(next_carts, cart_id);
+            break;
+        case scq::cart_order::round_robin:
         {
-            return memory_region().empty();
+            id_list_t & slot_queue = slot_queues[full_cart.first.value];
+
+            // the slot had no other full cart, i.e. it is in turn after all other slots of the partition
+            if (slot_queue.empty())
+                internal_partition.slots.push_back(next_slots, full_cart.first.value);
+
+            slot_queue.push_back(next_carts, cart_id);
+            break;
+        }
         }
 
-        bool full() const
+        // the partition is in turn for consumers of any partition after all other partitions with full carts
+        if (!internal_partition.pending)
         {
-            return size() >= capacity();
+            internal_partition.pending = true;
+            pending_partitions.push_back(next_partitions, partition);
         }
 
-        void emplace_back(value_t value)
+        return true;
+    }
+
+    // Suspends the async consumer unless a full cart is available or all carts were handed out; in that case, the
+    // waiter's full_cart and status are assigned and false is returned.
+    bool suspend_dequeue(async_dequeue_waiter_t & waiter)
+    {
+        std::unique_lock<std::mutex> full_cart_queue_lock(full_cart_queue_mutex);
+
+        if (full_carts_ring.enabled())
         {
-            assert(size() < capacity());
-            std::span<value_t> _memory_region = memory_region();
-            _memory_region = std::span<value_t>(_memory_region.data(), _memory_region.size() + 1u);
-            _memory_region.back() = std::move(value);
-            set_memory_region(_memory_region);
+            register_ring_waiter();
+
+            std::optional<size_t> cart_id = full_carts_ring.pop();
+
+            if (cart_id.has_value() || closed)
+            {
+                ring_waiter_count.fetch_sub(1u, std::memory_order_relaxed);
+                waiter.status = cart_id.has_value() ? queue_op_status::ok : queue_op_status::closed;
+
+                if (cart_id.has_value())
+                    waiter.full_cart = full_carts[*cart_id];
+
+                return false;
+            }
+
+            async_dequeue_waiters.push_back(waiter);
+            return true;
         }
 
-        void set_memory_region(std::span<value_t> memory_region_span)
+        if (!empty())
         {
-            assert(memory_region_ptr != nullptr);
-            *memory_region_ptr = std::span<value_t>{memory_region_span};
+            waiter.full_cart = pop(next_pending_partition());
+            waiter.status = queue_op_status::ok;
+            return false;
         }
 
-        std::span<value_t> memory_region() const
+        if (closed && drained(any_partition))
         {
-            assert(memory_region_ptr != nullptr);
-            return *memory_region_ptr;
+            waiter.status = queue_op_status::closed;
+            return false;
         }
-    };
 
-    slot_cart_t slot(scq::slot_id slot_id)
+        async_dequeue_waiters.push_back(waiter);
+        return true;
+    }
+
+    // Once the queue was closed and all carts were handed out, the suspended async consumers are woken up empty-handed.
+    // Expects the lock to be locked.
+    void take_async_waiters_if_drained(async_waiter_list_t & woken_waiters)
     {
-        std::span<value_t> & memory_region = internal_cart_slots[slot_id.value];
-        return {slot_id.value, cart_capacity, &memory_region};
+        if (!closed || !drained(any_partition))
+            return;
+
+        while (!async_dequeue_waiters.empty())
+        {
+            auto & waiter = static_cast<async_dequeue_waiter_t &>(async_dequeue_waiters.pop_front());
+            waiter.status = queue_op_status::closed;
+            woken_waiters.push_back(waiter);
+        }
     }
 
-    void move_active_carts_into_full_carts_queue(full_carts_queue_t & full_carts_queue)
+    // Blocks until a full cart of the partition (or of any partition) is available. Assigns full_cart only if the
+    // returned status is queue_op_status::ok.
+    template <typename wait_t>
+    queue_op_status dequeue(full_cart_type & full_cart, size_t partition, wait_t const & wait)
     {
-        // TODO: if pending slots are more than queue capacity? is that a problem?
+        if (full_carts_ring.enabled())
+        {
+            std::optional<size_t> cart_id{};
+            queue_op_status const status = dequeue_from_ring(cart_id, wait);
+
+            if (status == queue_op_status::ok)
+                full_cart = full_carts[*cart_id];
+
+            return status;
+        }
+
+        std::unique_lock<std::mutex> full_cart_queue_lock(full_cart_queue_mutex);
+
+        queue_op_status const status = wait_until_not_empty(full_cart_queue_lock, partition, wait);
+
+        if (status == queue_op_status::ok)
+            full_cart = pop(partition);
+
+        consumer_wakeup_t const wakeup = wakeup_after_dequeue(partition);
+        full_cart_queue_lock.unlock();
 
-        // put all non-empty / non-full carts into full queue (no element can't be added any more and all pending
-        // elements = active to fill elements must be processed)
-        for (size_t slot_id = 0u; slot_id < internal_cart_slots.size(); ++slot_id)
+        wake_up(wakeup);
+        return status;
+    }
+
+    // Blocks until a full cart of the partition (or of any partition) is available and appends up to max_count full
+    // carts to dequeued_carts.
+    template <typename wait_t>
+    queue_op_status
+    dequeue_n(std::vector<full_cart_type> & dequeued_carts, size_t max_count, size_t partition, wait_t const & wait)
+    {
+        if (full_carts_ring.enabled())
         {
-            auto slot_cart = slot(scq::slot_id{slot_id});
-            if (!slot_cart.empty())
+            std::optional<size_t> cart_id{};
+            queue_op_status const status = dequeue_from_ring(cart_id, wait);
+
+            for (size_t count = 0u; cart_id.has_value(); cart_id = full_carts_ring.pop())
             {
-                auto full_cart = full_carts_queue_t::move_slot_cart_to_full_cart(slot_cart);
-                full_carts_queue.enqueue(full_cart);
-                full_carts_queue.check_invariant();
+                dequeued_carts.push_back(full_carts[*cart_id]);
+
+                if (++count == max_count)
+                    break;
             }
+
+            return status;
+        }
+
+        std::unique_lock<std::mutex> full_cart_queue_lock(full_cart_queue_mutex);
+
+        queue_op_status const status = wait_until_not_empty(full_cart_queue_lock, partition, wait);
+
+        if (status == queue_op_status::ok)
+        {
+            for (size_t i = 0; i < max_count && !empty(partition); ++i)
+                dequeued_carts.push_back(pop(partition));
         }
+
+        consumer_wakeup_t const wakeup = wakeup_after_dequeue(partition);
+        full_cart_queue_lock.unlock();
+
+        wake_up(wakeup);
+        return status;
     }
 
-    size_t cart_capacity{};
+    // Blocks until a full cart of the partition (or of any partition) is available and appends it and all other full
+    // carts of its slot to dequeued_carts; with exclusive slots, this includes the held back carts of the slot.
+    template <typename wait_t>
+    queue_op_status dequeue_slot(std::vector<full_cart_type> & dequeued_carts, size_t partition, wait_t const & wait)
+    {
+        if (full_carts_ring.enabled())
+            throw std::logic_error{"dequeue_coalesced is not supported with lock-free full carts."};
 
-    std::vector<std::span<value_t>> internal_cart_slots{}; // position is slot_id
-};
+        std::unique_lock<std::mutex> full_cart_queue_lock(full_cart_queue_mutex);
 
-template <typename value_t>
-struct slotted_cart_queue<value_t>::empty_carts_queue_t
-{
-    empty_carts_queue_t() = default;
-    empty_carts_queue_t(carts carts, queue_memory_t & queue_memory) :
-        count{static_cast<std::ptrdiff_t>(carts.value)},
-        cart_count{carts.value},
-        internal_queue{}
+        queue_op_status const status = wait_until_not_empty(full_cart_queue_lock, partition, wait);
+
+        if (status == queue_op_status::ok)
+        {
+            size_t const slot_partition = partition == any_partition ? next_pending_partition() : partition;
+
+            dequeued_carts.push_back(pop(slot_partition));
+            pop_slot_carts(slot_partition, dequeued_carts.back().first, dequeued_carts);
+        }
+
+        consumer_wakeup_t const wakeup = wakeup_after_dequeue(partition);
+        full_cart_queue_lock.unlock();
+
+        wake_up(wakeup);
+        return status;
+    }
+
+    template <typename wait_t>
+    queue_op_status
+    wait_until_not_empty(std::unique_lock<std::mutex> & full_cart_queue_lock, size_t partition, wait_t const & wait)
     {
-        internal_queue.reserve(count);
+        auto const predicate = [this, partition]
+        {
+            // wait until first cart is full; held back carts become available eventually
+            return !empty(partition) || (closed && drained(partition));
+        };
+
+        // the spinning threads only take the lock once some cart is available (or the queue was closed)
+        bool ready = spin_locked_until(wait_strategy,
+                                       wait,
+                                       full_cart_queue_lock,
+                                       predicate,
+                                       [this]
+                                       {
+                                           return count.value.load(std::memory_order_relaxed) > 0 || closed;
+                                       });
+
+        if (!ready)
+        {
+            bool const any = partition == any_partition;
+            size_t & waiter_count = any ? any_partition_waiter_count : internal_partitions[partition].waiter_count;
+
+            ++waiter_count;
+            ready = wait(any ? any_partition_cv : internal_partitions[partition].not_empty_cv,
+                         full_cart_queue_lock,
+                         predicate);
+            --waiter_count;
+        }
 
-        for (size_t i = 0; i < cart_count; ++i)
-            internal_queue.push_back(queue_memory.memory_region(cart_memory_id{i}));
+        if (!ready)
+            return queue_op_status::timeout;
+
+        if (empty(partition)) // closed and all carts were dequeued
+            return queue_op_status::closed;
+
+        return queue_op_status::ok;
     }
 
-    bool empty()
+    // Removes the next full cart of the partition. Expects the lock to be locked and the partition not to be empty.
+    full_cart_type pop(size_t partition)
+    {
+        --count.value;
+        check_invariant();
+
+        if (partition == any_partition)
+            partition = next_pending_partition();
+
+        partition_t & internal_partition = internal_partitions[partition];
+        --internal_partition.count;
+
+        if (order != scq::cart_order::round_robin)
+            return full_carts[internal_partition.carts.pop_front(next_carts)];
+
+        size_t const slot = internal_partition.slots.pop_front(next_slots);
+        id_list_t & slot_queue = slot_queues[slot];
+
+        size_t const cart_id = slot_queue.pop_front(next_carts);
+
+        if (!slot_queue.empty()) // the slot has further full carts, it is in turn again after all other slots
+            internal_partition.slots.push_back(next_slots, slot);
+
+        return full_carts[cart_id];
+    }
+
+    // Removes all available and held back full carts of the slot. Expects the lock to be locked.
+    void pop_slot_carts(size_t partition, slot_id slot, std::vector<full_cart_type> & dequeued_carts)
     {
-        return count == 0;
+        partition_t & internal_partition = internal_partitions[partition];
+
+        auto pop_cart = [&](size_t cart_id)
+        {
+            dequeued_carts.push_back(full_carts[cart_id]);
+        };
+
+        size_t popped_count{};
+
+        if (order != scq::cart_order::round_robin)
+        {
+            popped_count = internal_partition.carts.remove_if(
+                next_carts,
+                [&](size_t cart_id)
+                {
+                    return full_carts[cart_id].first.value == slot.value;
+                },
+                pop_cart);
+        }
+        else if (id_list_t & slot_queue = slot_queues[slot.value]; !slot_queue.empty())
+        {
+            internal_partition.slots.remove_if(
+                next_slots,
+                [&](size_t slot_id)
+                {
+                    return slot_id == slot.value;
+                },
+                [](size_t) {});
+
+            for (; !slot_queue.empty(); ++popped_count)
+                pop_cart(slot_queue.pop_front(next_carts));
+        }
+
+        count.value -= static_cast<std::ptrdiff_t>(popped_count);
+        internal_partition.count -= popped_count;
+        check_invariant();
+
+        if (!exclusive_slots)
+            return;
+
+        for (id_list_t & held_carts = exclusive_slot_states[slot.value].held_carts; !held_carts.empty();)
+        {
+            pop_cart(held_carts.pop_front(next_carts));
+            --internal_partition.held_count;
+            --held_count;
+        }
     }
 
-    void enqueue(std::span<value_t> memory_region)
+    // Returns the partition that is in turn for the consumers of any partition. The partitions without full carts are
+    // only removed from the pending partitions here. Expects that some partition is not empty.
+    size_t next_pending_partition()
     {
-        internal_queue.push_back(std::span<value_t>{memory_region.data(), 0});
+        while (true)
+        {
+            size_t const partition = pending_partitions.pop_front(next_partitions);
+            partition_t & internal_partition = internal_partitions[partition];
+
+            if (internal_partition.count == 0u)
+            {
+                internal_partition.pending = false;
+                continue;
+            }
+
+            if (internal_partition.count > 1u)
+                pending_partitions.push_back(next_partitions, partition);
+            else
+                internal_partition.pending = false;
 
-        ++count;
+            return partition;
+        }
     }
 
-    std::span<value_t> dequeue()
+    void close()
     {
-        --count;
+        async_waiter_list_t woken_waiters{};
 
-        std::span<value_t> memory_region{internal_queue.back().data(), 0};
-        internal_queue.pop_back();
-        return memory_region;
+        {
+            std::unique_lock<std::mutex> full_cart_queue_lock(full_cart_queue_mutex);
+            closed = true;
+
+            if (full_carts_ring.enabled())
+                take_ring_async_waiters(woken_waiters);
+            else
+                take_async_waiters_if_drained(woken_waiters);
+        }
+
+        wake_up(consumer_wakeup_t{.all = true});
+        std::move(woken_waiters).wake_all();
     }
 
-    void check_invariant()
+    // Blocks until a full cart was popped from the ring (or the queue was closed and the ring is empty). The consumers
+    // only take the lock if they have to block.
+    template <typename wait_t>
+    queue_op_status dequeue_from_ring(std::optional<size_t> & cart_id, wait_t const & wait)
     {
-        assert(0 <= count);
-        assert(count <= static_cast<std::ptrdiff_t>(cart_count));
+        auto const ready = [this, &cart_id]
+        {
+            // No further carts are pushed after the queue was closed. The flag is read before the ring: the last cart
+            // might be pushed right before the queue is closed, i.e. after a pop that found the ring empty.
+            bool const was_closed = closed;
+            return (cart_id = full_carts_ring.pop()).has_value() || was_closed;
+        };
 
-        if (!(0 <= count))
-            throw std::runtime_error{"empty_carts_queue.count: negative"};
+        if (!ready() && !detail::spin_until(wait_strategy, wait, ready))
+        {
+            if (wait.expired())
+                return queue_op_status::timeout;
 
-        if (!(count <= static_cast<std::ptrdiff_t>(cart_count)))
-            throw std::runtime_error{std::string{"empty_carts_queue.count: FULL, count: "} + std::to_string(count)
-                                     + " <= " + std::to_string(cart_count)};
+            std::unique_lock<std::mutex> full_cart_queue_lock(full_cart_queue_mutex);
+
+            register_ring_waiter();
+            ++any_partition_waiter_count;
+
+            bool const woken = wait(any_partition_cv, full_cart_queue_lock, ready);
+
+            --any_partition_waiter_count;
+            ring_waiter_count.fetch_sub(1u, std::memory_order_relaxed);
+
+            // each cart woke up a single consumer, which might not have been the one that took it
+            bool const pass_on = cart_id.has_value() && any_partition_waiter_count > 0u && !full_carts_ring.empty();
+            full_cart_queue_lock.unlock();
+
+            if (pass_on)
+                any_partition_cv.notify_one();
+
+            if (!woken)
+                return queue_op_status::timeout;
+        }
+
+        return cart_id.has_value() ? queue_op_status::ok : queue_op_status::closed;
     }
 
-    std::atomic<std::ptrdiff_t> count{};
-    size_t cart_count{};
+    // The waiter is registered before the ring is checked, i.e. either the pushing thread sees the waiter or the
+    // waiter sees the pushed cart (both the push and the pop access the cell with seq_cst). Expects the lock to be
+    // locked.
+    void register_ring_waiter()
+    {
+        ring_waiter_count.fetch_add(1u, std::memory_order_seq_cst);
+    }
 
-    std::vector<std::span<value_t>> internal_queue{};
-};
+    // Hands the pushed cart over to a suspended async consumer or wakes up a blocked consumer; the lock is only taken
+    // if there are any.
+    void notify_ring_waiters()
+    {
+        if (ring_waiter_count.load(std::memory_order_seq_cst) == 0u)
+            return;
 
-template <typename value_t>
-struct slotted_cart_queue<value_t>::full_carts_queue_t
-{
-    using full_cart_type = std::pair<slot_id, std::span<value_t>>;
-    using slot_cart_type = typename cart_slots_t::slot_cart_t;
+        consumer_wakeup_t wakeup{};
+        async_waiter_list_t woken_waiters{};
 
-    full_carts_queue_t() = default;
-    full_carts_queue_t(carts carts) : count{0}, cart_count{carts.value}
+        {
+            std::unique_lock<std::mutex> full_cart_queue_lock(full_cart_queue_mutex);
+            take_ring_async_waiters(woken_waiters);
+
+            if (any_partition_waiter_count > 0u && !full_carts_ring.empty())
+                wakeup.cv = &any_partition_cv;
+        }
+
+        wake_up(wakeup);
+        std::move(woken_waiters).wake_all();
+    }
+
+    // Hands the carts of the ring over to the suspended async consumers; once the queue was closed and the ring is
+    // empty, the remaining ones are woken up empty-handed. Expects the lock to be locked.
+    void take_ring_async_waiters(async_waiter_list_t & woken_waiters)
     {
-        internal_queue.reserve(cart_count);
+        while (!async_dequeue_waiters.empty())
+        {
+            std::optional<size_t> cart_id = full_carts_ring.pop();
+
+            if (!cart_id.has_value() && !closed)
+                break;
+
+            auto & waiter = static_cast<async_dequeue_waiter_t &>(async_dequeue_waiters.pop_front());
+            waiter.status = cart_id.has_value() ? queue_op_status::ok : queue_op_status::closed;
+
+            if (cart_id.has_value())
+                waiter.full_cart = full_carts[*cart_id];
+
+            ring_waiter_count.fetch_sub(1u, std::memory_order_relaxed);
+            woken_waiters.push_back(waiter);
+        }
     }
 
-    bool empty()
+    // The blocked consumers that are woken up after the lock was released: a single consumer per cart that became
+    // available, or all consumers once the queue is closed, since they return as soon as their partition is drained.
+    struct consumer_wakeup_t
+    {
+        std::condition_variable * cv{nullptr};
+        bool all{false};
+    };
+
+    // Returns the condition variable of a blocked consumer that can take a cart of the partition, preferring the
+    // consumers of the partition over the consumers of any partition. Expects the lock to be locked.
+    std::condition_variable * waiting_consumer(size_t partition)
     {
-        return count == 0;
+        if (internal_partitions[partition].waiter_count > 0u)
+            return &internal_partitions[partition].not_empty_cv;
+
+        if (any_partition_waiter_count > 0u)
+            return &any_partition_cv;
+
+        return nullptr;
     }
 
-    static full_cart_type move_slot_cart_to_full_cart(slot_cart_type & slot_cart)
+    // A consumer that left carts behind passes its wakeup on to the next blocked consumer; each cart only woke up a
+    // single consumer, which might have taken several carts or none at all. Expects the lock to be locked.
+    consumer_wakeup_t wakeup_after_dequeue(size_t partition)
     {
-        assert(slot_cart.size() > 0);                     // at least one element
-        assert(slot_cart.size() <= slot_cart.capacity()); // at most cart capacity many elements
+        if (closed)
+            return {.all = true};
 
-        full_cart_type full_cart{slot_cart.slot_id(), slot_cart.memory_region()};
-        slot_cart.set_memory_region(std::span<value_t>{}); // reset slot
-        return full_cart;
+        if (partition != any_partition)
+            return {.cv = empty(partition) ? nullptr : waiting_consumer(partition)};
+
+        return {.cv = !empty() && any_partition_waiter_count > 0u ? &any_partition_cv : nullptr};
     }
 
-    void enqueue(full_cart_type full_cart)
+    void wake_up(consumer_wakeup_t const & wakeup)
     {
-        ++count;
+        if (wakeup.all)
+        {
+            for (partition_t & internal_partition : internal_partitions)
+                internal_partition.not_empty_cv.notify_all();
 
-        internal_queue.push_back(full_cart);
+            any_partition_cv.notify_all();
+        }
+        else if (wakeup.cv != nullptr)
+        {
+            wakeup.cv->notify_one();
+        }
     }
 
-    full_cart_type dequeue()
+    // Calls fn for each full cart that was not dequeued. Expects that no thread accesses the queue concurrently.
+    template <typename fn_t>
+    void for_each_cart(fn_t && fn)
     {
-        --count;
+        // the ring can only be iterated by emptying it
+        while (std::optional<size_t> cart_id = full_carts_ring.pop())
+            fn(full_carts[*cart_id]);
+
+        auto for_each_id = [](id_list_t const & list, std::pmr::vector<size_t> const & next, auto && id_fn)
+        {
+            for (size_t id = list.first; id != no_id; id = next[id])
+                id_fn(id);
+        };
+
+        for (exclusive_slot_state_t const & slot_state : exclusive_slot_states)
+        {
+            for_each_id(slot_state.held_carts,
+                        next_carts,
+                        [&](size_t cart_id)
+                        {
+                            fn(full_carts[cart_id]);
+                        });
+        }
+
+        for (partition_t const & internal_partition : internal_partitions)
+        {
+            if (order != scq::cart_order::round_robin)
+            {
+                for_each_id(internal_partition.carts,
+                            next_carts,
+                            [&](size_t cart_id)
+                            {
+                                fn(full_carts[cart_id]);
+                            });
+                continue;
+            }
 
-        full_cart_type tmp = std::move(internal_queue.back());
-        internal_queue.pop_back();
-        return tmp;
+            for_each_id(internal_partition.slots,
+                        next_slots,
+                        [&](size_t slot)
+                        {
+                            for_each_id(slot_queues[slot],
+                                        next_carts,
+                                        [&](size_t cart_id)
+                                        {
+                                            fn(full_carts[cart_id]);
+                                        });
+                        });
+        }
     }
 
     void check_invariant()
     {
-        assert(0 <= count);
-        assert(count <= static_cast<std::ptrdiff_t>(cart_count));
+        assert(0 <= count.value);
+        assert(count.value <= static_cast<std::ptrdiff_t>(cart_count));
 
-        if (!(0 <= count))
+        if (!(0 <= count.value))
             throw std::runtime_error{"full_carts_queue.count: negative"};
 
-        if (!(count <= static_cast<std::ptrdiff_t>(cart_count)))
-            throw std::runtime_error{std::string{"full_carts_queue.count: FULL, count: "} + std::to_string(count)
+        if (!(count.value <= static_cast<std::ptrdiff_t>(cart_count)))
+            throw std::runtime_error{std::string{"full_carts_queue.count: FULL, count: "} + std::to_string(count.value)
                                      + " <= " + std::to_string(cart_count)};
     }
 
-    std::atomic<std::ptrdiff_t> count{};
+    // A singly linked list of ids; the successor of an id is stored in a vector that is shared by all lists over the
+    // same kind of ids, since an id is in at most one list at a time.
+    struct id_list_t
+    {
+        bool empty() const
+        {
+            return first == no_id;
+        }
+
+        void push_back(std::pmr::vector<size_t> & next, size_t id)
+        {
+            next[id] = no_id;
+
+            if (empty())
+                first = id;
+            else
+                next[last] = id;
+
+            last = id;
+        }
+
+        void push_front(std::pmr::vector<size_t> & next, size_t id)
+        {
+            next[id] = first;
+
+            if (empty())
+                last = id;
+
+            first = id;
+        }
+
+        size_t pop_front(std::pmr::vector<size_t> const & next)
+        {
+            assert(!empty());
+
+            size_t const id = std::exchange(first, next[first]);
+
+            if (empty())
+                last = no_id;
+
+            return id;
+        }
+
+        // Removes all ids for which predicate(id) holds and calls fn(id) for them. Returns the number of removed ids.
+        template <typename predicate_t, typename fn_t>
+        size_t remove_if(std::pmr::vector<size_t> & next, predicate_t && predicate, fn_t && fn)
+        {
+            size_t removed_count{};
+
+            for (size_t id = first, previous = no_id; id != no_id;)
+            {
+                size_t const next_id = next[id];
+
+                if (!predicate(id))
+                {
+                    previous = std::exchange(id, next_id);
+                    continue;
+                }
+
+                fn(id);
+                ++removed_count;
+
+                if (previous == no_id)
+                    first = next_id;
+                else
+                    next[previous] = next_id;
+
+                if (id == last)
+                    last = previous;
+
+                id = next_id;
+            }
+
+            return removed_count;
+        }
+
+        size_t first{no_id};
+        size_t last{no_id};
+    };
+
+    struct partition_t
+    {
+        size_t count{};      // number of available full carts of the partition
+        size_t held_count{}; // exclusive_slots: number of held back full carts of the partition
+        bool pending{false}; // whether the partition is in pending_partitions
+        id_list_t carts{};   // lifo, fifo: the full carts of the partition
+        id_list_t slots{};   // round_robin: the slots of the partition that have full carts
+
+        size_t waiter_count{}; // number of consumers of the partition that are blocked
+        std::condition_variable not_empty_cv{};
+    };
+
+    struct exclusive_slot_state_t
+    {
+        bool blocked{false};    // whether a cart of the slot is available or being processed
+        id_list_t held_carts{}; // the full carts of the slot that are held back
+    };
+
+    // The count is written whenever a cart is published or handed out and read by spinning consumers, so it fills a
+    // cache line of its own. The read-mostly members from cart_count to full_carts_ring share the following lines; the
+    // ring waiter count and the mutex with the state it protects each start a new line.
+    struct alignas(std::hardware_destructive_interference_size) padded_count_t
+    {
+        std::atomic<std::ptrdiff_t> value{}; // number of available full carts
+    };
+
+    static_assert(sizeof(padded_count_t) == std::hardware_destructive_interference_size,
+                  "The count must not share its cache line with the members after it.");
+
+    padded_count_t count{};
     size_t cart_count{};
+    size_t slot_count{};
+    scq::cart_order order{};
+    bool exclusive_slots{};
+    scq::wait_strategy wait_strategy{};
+    std::atomic_bool closed{false};
+
+    std::pmr::vector<full_cart_type> full_carts{}; // position is cart_memory_id
+    std::pmr::vector<size_t> next_carts{};         // position is cart_memory_id
+
+    std::pmr::vector<partition_t> internal_partitions{}; // position is partition_id
+    std::pmr::vector<size_t> next_partitions{};          // position is partition_id
+
+    std::pmr::vector<id_list_t> slot_queues{}; // round_robin: position is slot_id
+    std::pmr::vector<size_t> next_slots{};     // round_robin: position is slot_id
+
+    std::pmr::vector<exclusive_slot_state_t> exclusive_slot_states{}; // exclusive_slots: position is slot_id
+
+    detail::cart_id_ring full_carts_ring{}; // lock_free_full_carts: the full carts in the order they were published
+    // lock_free_full_carts: number of blocked consumers plus the number of suspended async consumers
+    alignas(std::hardware_destructive_interference_size) std::atomic<size_t> ring_waiter_count{0u};
 
-    std::vector<full_cart_type> internal_queue{};
+    alignas(std::hardware_destructive_interference_size) std::mutex full_cart_queue_mutex;
+    size_t held_count{};                         // exclusive_slots: number of held back full carts
+    id_list_t pending_partitions{};              // the partitions that might have full carts
+    async_waiter_list_t async_dequeue_waiters{}; // consumers of any partition
+    size_t any_partition_waiter_count{};         // number of consumers of any partition that are blocked
+    std::condition_variable any_partition_cv;
 };
 
 } // namespace scq
@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for Test, TestInfo, Message, TEST, EXPECT_EQ, TestPartResult
+
+#include <algorithm> // for ranges::sort
+#include <atomic>    // for atomic
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint32_t, uint64_t
+#include <numeric>   // for iota
+#include <optional>  // for optional, nullopt
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include <scq/detail/lock_free_cart_ids.hpp> // for cart_id_stack
+
+TEST(lock_free_cart_ids_test, stack_push_pop)
+{
+    scq::detail::cart_id_stack stack{5u};
+
+    EXPECT_TRUE(stack.empty());
+    EXPECT_EQ(stack.pop(), std::nullopt);
+
+    stack.push(3u);
+    stack.push(0u);
+    stack.push(4u);
+    EXPECT_FALSE(stack.empty());
+
+    // last in, first out
+    EXPECT_EQ(stack.pop(), std::optional<size_t>{4u});
+    EXPECT_EQ(stack.pop(), std::optional<size_t>{0u});
+
+    stack.push(1u);
+    EXPECT_EQ(stack.pop(), std::optional<size_t>{1u});
+    EXPECT_EQ(stack.pop(), std::optional<size_t>{3u});
+
+    EXPECT_TRUE(stack.empty());
+    EXPECT_EQ(stack.pop(), std::nullopt);
+}
+
+// The ids of a range are pushed as if they were pushed one by one.
+TEST(lock_free_cart_ids_test, stack_push_range)
+{
+    scq::detail::cart_id_stack stack{6u};
+
+    stack.push(5u);
+    EXPECT_EQ(stack.push_range(std::vector<size_t>{}), 0u);
+    EXPECT_EQ(stack.push_range(std::vector<size_t>{0u, 1u, 2u}), 3u);
+    EXPECT_EQ(stack.push_range(std::vector<size_t>{4u}), 1u);
+
+    std::vector<size_t> popped_ids{};
+    for (std::optional<size_t> cart_id = stack.pop(); cart_id.has_value(); cart_id = stack.pop())
+        popped_ids.push_back(*cart_id);
+
+    EXPECT_EQ(popped_ids, (std::vector<size_t>{4u, 2u, 1u, 0u, 5u}));
+}
+
+// A pop that read the top before the top was popped and pushed again fails, although the top has the same id (ABA).
+TEST(lock_free_cart_ids_test, stack_tag_prevents_aba)
+{
+    scq::detail::cart_id_stack stack{3u};
+    stack.push(0u);
+    stack.push(1u);
+
+    std::atomic<uint64_t> & top = stack.tops[0].top;
+    uint64_t stale_top = top.load();
+    uint32_t const stale_next_id = stack.next_ids[1].load();
+    EXPECT_EQ(scq::detail::cart_id_stack::top_id(stale_top), 1u);
+    EXPECT_EQ(stale_next_id, 0u);
+
+    // meanwhile, another thread pops 1 and 0 and pushes 1 again, i.e. 0 is no longer in the stack
+    EXPECT_EQ(stack.pop(), std::optional<size_t>{1u});
+    EXPECT_EQ(stack.pop(), std::optional<size_t>{0u});
+    stack.push(1u);
+    EXPECT_EQ(scq::detail::cart_id_stack::top_id(top.load()), 1u);
+
+    EXPECT_FALSE(top.compare_exchange_strong(stale_top,
+                                             scq::detail::cart_id_stack::make_top(stale_top, stale_next_id)));
+
+    EXPECT_EQ(stack.pop(), std::optional<size_t>{1u});
+    EXPECT_EQ(stack.pop(), std::nullopt);
+}
+
+// The tag wraps around after 2^32 operations without touching the id.
+TEST(lock_free_cart_ids_test, stack_tag_wraps)
+{
+    uint64_t const last_tag_top = (uint64_t{0xFFFF'FFFFu} << 32) | 7u;
+    EXPECT_EQ(scq::detail::cart_id_stack::make_top(last_tag_top, 3u), 3u);
+
+    scq::detail::cart_id_stack stack{4u};
+    stack.push(2u);
+    stack.tops[0].top.store((uint64_t{0xFFFF'FFFFu} << 32) | 2u);
+
+    EXPECT_EQ(stack.pop(), std::optional<size_t>{2u});
+    EXPECT_EQ(stack.tops[0].top.load(), scq::detail::cart_id_stack::no_id);
+    EXPECT_TRUE(stack.empty());
+
+    stack.push(1u);
+    EXPECT_EQ(stack.pop(), std::optional<size_t>{1u});
+    EXPECT_EQ(stack.pop(), std::nullopt);
+}
+
+// Threads concurrently pop ids and push them back, one by one and as ranges; afterwards, each id is in the stack
+// exactly once.
+TEST(lock_free_cart_ids_test, stack_concurrent_conservation)
+{
+    size_t const cart_count = 64u;
+    size_t const thread_count = 8u;
+    size_t const rounds_per_thread = 20000u;
+
+    scq::detail::cart_id_stack stack{cart_count};
+
+    std::vector<size_t> all_ids(cart_count);
+    std::iota(all_ids.begin(), all_ids.end(), 0u);
+    stack.push_range(all_ids);
+
+    std::vector<std::thread> threads{};
+    for (size_t thread_id = 0u; thread_id < thread_count; ++thread_id)
+    {
+        threads.emplace_back(
+            [&stack, thread_id]()
+            {
+                std::vector<size_t> popped_ids{};
+
+                for (size_t round = 0u; round < rounds_per_thread; ++round)
+                {
+                    for (size_t i = 0u; i < 1u + (round + thread_id) % 3u; ++i)
+                        if (std::optional<size_t> cart_id = stack.pop(); cart_id.has_value())
+                            popped_ids.push_back(*cart_id);
+
+                    if (round % 2u == 0u)
+                    {
+                        stack.push_range(popped_ids);
+                    }
+                    else
+                    {
+                        for (size_t cart_id : popped_ids)
+                            stack.push(cart_id);
+                    }
+
+                    popped_ids.clear();
+                }
+            });
+    }
+
+    for (std::thread & thread : threads)
+        thread.join();
+
+    std::vector<size_t> remaining_ids{};
+    for (std::optional<size_t> cart_id = stack.pop(); cart_id.has_value(); cart_id = stack.pop())
+        remaining_ids.push_back(*cart_id);
+
+    std::ranges::sort(remaining_ids);
+    EXPECT_EQ(remaining_ids, all_ids);
+}
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <array>   // for array
+#include <cstddef> // for size_t
+#include <cstdint> // for uintptr_t
+#include <new>     // for hardware_destructive_interference_size
+#include <set>     // for set
+#include <utility> // for pair
+#include <vector>  // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future
+
+#include "../slotted_cart_queue_types.hpp" // for slotted_cart_queue_types, slotted_cart_queue_type_names, cart_futu...
+
+// A value whose size does not divide the size of a cache line.
+using odd_value_type = std::array<char, 5>;
+
+template <typename queue_t>
+class multiple_item_cart_cache_line : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(multiple_item_cart_cache_line,
+                 slotted_cart_queue_types<odd_value_type>,
+                 slotted_cart_queue_type_names);
+
+// Each cart starts on a cache line of its own, i.e. two carts never share a cache line.
+TYPED_TEST(multiple_item_cart_cache_line, carts_are_aligned)
+{
+    size_t const slot_count = 3u;
+    size_t const cart_count = 6u;
+    size_t const cart_capacity = 7u;
+
+    TypeParam queue{{.slots = slot_count, .carts = cart_count, .capacity = cart_capacity}};
+
+    std::set<std::uintptr_t> cart_addresses{};
+
+    // fills all carts
+    for (size_t i = 0u; i < cart_count * cart_capacity; ++i)
+        queue.enqueue(scq::slot_id{i % slot_count}, odd_value_type{static_cast<char>(i % slot_count)});
+
+    for (size_t cart = 0u; cart < cart_count; ++cart)
+    {
+        cart_future_t<TypeParam> cart_future = queue.dequeue();
+        ASSERT_TRUE(cart_future.valid());
+
+        std::pair<scq::slot_id, std::span<odd_value_type>> cart_data = cart_future.get();
+        EXPECT_EQ(cart_data.second.size(), cart_capacity);
+
+        for (odd_value_type const & value : cart_data.second)
+            EXPECT_EQ(static_cast<size_t>(value[0]), cart_data.first.value);
+
+        std::uintptr_t const address = reinterpret_cast<std::uintptr_t>(cart_data.second.data());
+        EXPECT_EQ(address % std::hardware_destructive_interference_size, 0u);
+        cart_addresses.insert(address);
+    }
+
+    // none of the carts share a cache line
+    ASSERT_EQ(cart_addresses.size(), cart_count);
+
+    std::vector<std::uintptr_t> const addresses(cart_addresses.begin(), cart_addresses.end());
+    for (size_t i = 1u; i < addresses.size(); ++i)
+        EXPECT_GE(addresses[i] - addresses[i - 1u], cart_capacity * sizeof(odd_value_type));
+
+    queue.close();
+}
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <cstddef> // for size_t
+#include <memory>  // for shared_ptr, make_shared
+#include <utility> // for pair
+#include <vector>  // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, cart_order
+
+// Enqueues the values into the slots (value / 100) of a queue with carts of capacity 2 and returns the first value of
+// each cart in the order the carts were dequeued.
+static std::vector<int> dequeue_order(scq::cart_order cart_order, std::vector<int> const & values)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 3, .carts = 8, .capacity = 2, .cart_order = cart_order}};
+
+    for (value_type value : values)
+        queue.enqueue(scq::slot_id{static_cast<size_t>(value / 100)}, value);
+
+    queue.close();
+
+    std::vector<int> first_values{};
+    for (scq::cart_future<value_type> cart = queue.dequeue(); cart.valid(); cart = queue.dequeue())
+    {
+        std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+        EXPECT_EQ(cart_data.second.size(), 2u);
+        first_values.push_back(cart_data.second[0]);
+    }
+
+    return first_values;
+}
+
+// slot 0 fills three carts, slot 1 one cart and slot 2 two carts
+static std::vector<int> const values{0, 1, 2, 3, 100, 101, 4, 5, 200, 201, 202, 203};
+
+TEST(multiple_item_cart_cart_order, lifo)
+{
+    EXPECT_EQ(dequeue_order(scq::cart_order::lifo, values), (std::vector<int>{202, 200, 4, 100, 2, 0}));
+}
+
+TEST(multiple_item_cart_cart_order, fifo)
+{
+    EXPECT_EQ(dequeue_order(scq::cart_order::fifo, values), (std::vector<int>{0, 2, 100, 4, 200, 202}));
+}
+
+TEST(multiple_item_cart_cart_order, round_robin)
+{
+    EXPECT_EQ(dequeue_order(scq::cart_order::round_robin, values), (std::vector<int>{0, 100, 200, 2, 202, 4}));
+}
+
+TEST(multiple_item_cart_cart_order, round_robin_interleaved)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{
+        {.slots = 3, .carts = 8, .capacity = 1, .cart_order = scq::cart_order::round_robin}};
+
+    // slot 0 gets full carts again after it was in turn
+    queue.enqueue(scq::slot_id{0}, 0);
+    queue.enqueue(scq::slot_id{1}, 100);
+    EXPECT_EQ(queue.dequeue().get().second[0], 0);
+
+    queue.enqueue(scq::slot_id{0}, 1);
+    queue.enqueue(scq::slot_id{2}, 200);
+    queue.enqueue(scq::slot_id{0}, 2);
+    EXPECT_EQ(queue.dequeue().get().second[0], 100);
+    EXPECT_EQ(queue.dequeue().get().second[0], 1);
+    EXPECT_EQ(queue.dequeue().get().second[0], 200);
+    EXPECT_EQ(queue.dequeue().get().second[0], 2);
+}
+
+TEST(multiple_item_cart_cart_order, destroy_unprocessed_elements)
+{
+    using value_type = std::shared_ptr<int>;
+
+    for (scq::cart_order cart_order : {scq::cart_order::lifo, scq::cart_order::fifo, scq::cart_order::round_robin})
+    {
+        value_type value = std::make_shared<int>(1);
+
+        {
+            scq::slotted_cart_queue<value_type> queue{
+                {.slots = 3, .carts = 8, .capacity = 1, .cart_order = cart_order}};
+
+            for (size_t slot : {0u, 1u, 0u, 2u, 0u})
+                queue.enqueue(scq::slot_id{slot}, value);
+
+            // one cart is processed, four full carts are never dequeued
+            EXPECT_EQ(queue.dequeue().get().second.size(), 1u);
+            EXPECT_EQ(value.use_count(), 5);
+        }
+
+        EXPECT_EQ(value.use_count(), 1);
+    }
+}
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <atomic>  // for atomic
+#include <cstddef> // for size_t
+#include <thread>  // for thread
+#include <vector>  // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, wait_strategy
+
+#include "../slotted_cart_queue_types.hpp" // for slotted_cart_queue_types, slotted_cart_queue_type_names, cart_futu...
+
+template <typename queue_t>
+class multiple_item_cart_close_after_last_enqueue : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(multiple_item_cart_close_after_last_enqueue,
+                 slotted_cart_queue_types<size_t>,
+                 slotted_cart_queue_type_names);
+
+// The queue is closed right after the last cart was published, while the consumers look for full carts. A consumer
+// that found no cart must not see the queue closed before the last cart, i.e. all elements are handed out.
+TYPED_TEST(multiple_item_cart_close_after_last_enqueue, all_elements_are_dequeued)
+{
+    using value_type = typename TypeParam::value_type;
+
+    size_t const consumer_count = 2u;
+    size_t const round_count = 200u;
+
+    for (scq::wait_strategy wait_strategy : {scq::wait_strategy::block,
+                                             scq::wait_strategy::spin,
+                                             scq::wait_strategy::spin_then_yield,
+                                             scq::wait_strategy::spin_then_block})
+    {
+        for (size_t round = 0u; round < round_count; ++round)
+        {
+            TypeParam queue{{.slots = 2,
+                             .carts = 4,
+                             .capacity = 2,
+                             .cart_order = scq::cart_order::fifo,
+                             .wait_strategy = wait_strategy,
+                             .lock_free_full_carts = true}};
+
+            std::atomic<size_t> value_sum{};
+
+            std::vector<std::thread> consumers{};
+            for (size_t consumer_id = 0u; consumer_id < consumer_count; ++consumer_id)
+            {
+                consumers.emplace_back(
+                    [&]()
+                    {
+                        for (cart_future_t<TypeParam> cart = queue.dequeue(); cart.valid(); cart = queue.dequeue())
+                            for (value_type value : cart.get().second)
+                                value_sum += value;
+                    });
+            }
+
+            // the second value completes a cart, the third one is in a cart that close publishes
+            queue.enqueue(scq::slot_id{0}, value_type{1});
+            queue.enqueue(scq::slot_id{0}, value_type{2});
+            queue.enqueue(scq::slot_id{1}, value_type{4});
+            queue.close();
+
+            for (std::thread & consumer : consumers)
+                consumer.join();
+
+            ASSERT_EQ(value_sum.load(), 7u) << "round " << round;
+        }
+    }
+}
@@ -5,8 +5,10 @@
 #include <gtest/gtest.h> // for AssertionResult, Test, Message, TestPartResult, TestInfo, EXPECT...
 
 #include <algorithm> // for generate
+#include <atomic>    // for atomic
 #include <chrono>    // for milliseconds
 #include <cstddef>   // for size_t
+#include <stdexcept> // for overflow_error
 #include <string>    // for basic_string
 #include <thread>    // for thread, sleep_for
 #include <utility>   // for pair
@@ -16,23 +18,28 @@
 
 #include "../atomic_count.hpp"              // for atomic_count
 #include "../concurrent_cross_off_list.hpp" // for concurrent_cross_off_list
+#include "../slotted_cart_queue_types.hpp"  // for slotted_cart_queue_types, slotted_cart_queue_type_names, cart_futu...
 
 static constexpr std::chrono::milliseconds wait_time(10);
 
-TEST(multiple_item_cart_close_queue, no_producer_no_consumer_close_is_non_blocking)
-{
-    using value_type = int;
+template <typename queue_t>
+class multiple_item_cart_close_queue : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(multiple_item_cart_close_queue, slotted_cart_queue_types<int>, slotted_cart_queue_type_names);
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+TYPED_TEST(multiple_item_cart_close_queue, no_producer_no_consumer_close_is_non_blocking)
+{
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     queue.close();
 }
 
-TEST(multiple_item_cart_close_queue, single_producer_no_consumer_enqueue_after_close)
+TYPED_TEST(multiple_item_cart_close_queue, single_producer_no_consumer_enqueue_after_close)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     queue.enqueue(scq::slot_id{1}, value_type{100});
     queue.enqueue(scq::slot_id{1}, value_type{101}); // one full cart
@@ -44,11 +51,11 @@ TEST(multiple_item_cart_close_queue, single_producer_no_consumer_enqueue_after_c
     EXPECT_THROW(queue.enqueue(scq::slot_id{2}, value_type{200}), std::overflow_error);
 }
 
-TEST(multiple_item_cart_close_queue, single_producer_no_consumer_release_blocking_enqueue_when_close)
+TYPED_TEST(multiple_item_cart_close_queue, single_producer_no_consumer_release_blocking_enqueue_when_close)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     // count number of enqueues
     atomic_count enqueue_count{};
@@ -93,11 +100,11 @@ TEST(multiple_item_cart_close_queue, single_producer_no_consumer_release_blockin
     EXPECT_EQ(enqueue_count.load(), 6);
 }
 
-TEST(multiple_item_cart_close_queue, multiple_producer_no_consumer_enqueue_after_close)
+TYPED_TEST(multiple_item_cart_close_queue, multiple_producer_no_consumer_enqueue_after_close)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     // count number of enqueues
     atomic_count enqueue_count{};
@@ -152,36 +159,32 @@ TEST(multiple_item_cart_close_queue, multiple_producer_no_consumer_enqueue_after
         enqueue_thread.join();
 }
 
-TEST(multiple_item_cart_close_queue, no_producer_single_consumer_dequeue_after_close)
+TYPED_TEST(multiple_item_cart_close_queue, no_producer_single_consumer_dequeue_after_close)
 {
-    using value_type = int;
-
     // close first then dequeue.
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     queue.close();
 
     // should be non-blocking if queue was closed (without close it would be blocking)
-    scq::cart_future<value_type> cart = queue.dequeue();
+    cart_future_t<TypeParam> cart = queue.dequeue();
 
     EXPECT_FALSE(cart.valid());
 
     EXPECT_THROW(cart.get(), std::future_error);
 }
 
-TEST(multiple_item_cart_close_queue, no_producer_single_consumer_release_blocking_dequeue_when_close)
+TYPED_TEST(multiple_item_cart_close_queue, no_producer_single_consumer_release_blocking_dequeue_when_close)
 {
-    using value_type = int;
-
     // dequeue first then close.
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     std::thread dequeue_thread{[&queue]
                                {
                                    // should be blocking if queue was not yet closed
-                                   scq::cart_future<value_type> cart = queue.dequeue();
+                                   cart_future_t<TypeParam> cart = queue.dequeue();
 
                                    EXPECT_FALSE(cart.valid());
 
@@ -197,20 +200,18 @@ TEST(multiple_item_cart_close_queue, no_producer_single_consumer_release_blockin
     dequeue_thread.join();
 }
 
-TEST(multiple_item_cart_close_queue, no_producer_multiple_consumer_dequeue_after_close)
+TYPED_TEST(multiple_item_cart_close_queue, no_producer_multiple_consumer_dequeue_after_close)
 {
-    using value_type = int;
-
     // close first then dequeue.
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     queue.close();
 
     for (int i = 0; i < 5; ++i) // TODO: this isn't really multiple consumer.
     {
         // should be non-blocking if queue was closed
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
 
         EXPECT_FALSE(cart.valid());
 
@@ -218,13 +219,11 @@ TEST(multiple_item_cart_close_queue, no_producer_multiple_consumer_dequeue_after
     }
 }
 
-TEST(multiple_item_cart_close_queue, no_producer_multiple_consumer_release_blocking_dequeue_when_close)
+TYPED_TEST(multiple_item_cart_close_queue, no_producer_multiple_consumer_release_blocking_dequeue_when_close)
 {
-    using value_type = int;
-
     // dequeue first then close.
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     // initialise 5 consuming threads
     std::vector<std::thread> dequeue_threads(5);
@@ -236,7 +235,7 @@ TEST(multiple_item_cart_close_queue, no_producer_multiple_consumer_release_block
                           [&queue]
                           {
                               // should be blocking if queue was not yet closed
-                              scq::cart_future<value_type> cart = queue.dequeue();
+                              cart_future_t<TypeParam> cart = queue.dequeue();
 
                               EXPECT_FALSE(cart.valid());
 
@@ -254,11 +253,11 @@ TEST(multiple_item_cart_close_queue, no_producer_multiple_consumer_release_block
         dequeue_thread.join();
 }
 
-TEST(multiple_item_cart_close_queue, single_producer_single_consumer_dequeue_after_close_process_full_carts)
+TYPED_TEST(multiple_item_cart_close_queue, single_producer_single_consumer_dequeue_after_close_process_full_carts)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -282,7 +281,7 @@ TEST(multiple_item_cart_close_queue, single_producer_single_consumer_dequeue_aft
     for (int i = 0; i < 6 / 2; ++i)
     {
         // close allows to dequeue remaining elements
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -298,11 +297,12 @@ TEST(multiple_item_cart_close_queue, single_producer_single_consumer_dequeue_aft
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(multiple_item_cart_close_queue, single_producer_single_consumer_dequeue_after_close_process_half_filled_carts)
+TYPED_TEST(multiple_item_cart_close_queue,
+           single_producer_single_consumer_dequeue_after_close_process_half_filled_carts)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -322,7 +322,7 @@ TEST(multiple_item_cart_close_queue, single_producer_single_consumer_dequeue_aft
     for (int i = 0; i < 4; ++i)
     {
         // close allows to dequeue remaining elements
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -338,12 +338,12 @@ TEST(multiple_item_cart_close_queue, single_producer_single_consumer_dequeue_aft
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(multiple_item_cart_close_queue,
-     single_producer_single_consumer_dequeue_after_close_process_mixed_full_and_half_filled_carts)
+TYPED_TEST(multiple_item_cart_close_queue,
+           single_producer_single_consumer_dequeue_after_close_process_mixed_full_and_half_filled_carts)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 7, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 7, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -380,7 +380,7 @@ TEST(multiple_item_cart_close_queue,
     for (int i = 0; i < 6 / 2 + 4; ++i)
     {
         // close allows to dequeue remaining elements
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -405,13 +405,13 @@ TEST(multiple_item_cart_close_queue,
 
 // TODO: add blocking enqueue test
 // TODO: add maybe blocking enqueue / dequeue test
-TEST(multiple_item_cart_close_queue, multiple_producer_multiple_consumer_release_blocking_dequeue_when_close)
+TYPED_TEST(multiple_item_cart_close_queue, multiple_producer_multiple_consumer_release_blocking_dequeue_when_close)
 {
     // this tests whether a blocking dequeue (= queue is empty) will be released by a close.
 
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 2, .carts = 3, .capacity = 2}};
+    TypeParam queue{{.slots = 2, .carts = 3, .capacity = 2}};
 
     // count number of enqueues
     atomic_count enqueue_count{};
@@ -481,7 +481,7 @@ TEST(multiple_item_cart_close_queue, multiple_producer_multiple_consumer_release
                               while (true)
                               {
                                   // should be blocking if queue was not yet closed
-                                  scq::cart_future<value_type> cart = queue.dequeue();
+                                  cart_future_t<TypeParam> cart = queue.dequeue();
 
                                   // abort if queue was closed
                                   if (!cart.valid())
@@ -529,3 +529,45 @@ TEST(multiple_item_cart_close_queue, multiple_producer_multiple_consumer_release
     // all results seen
     EXPECT_TRUE(expected.empty());
 }
+
+// close() races against the enqueue that completes the last cart; close() must return once that cart was published,
+// i.e. the producer must not miss waking up a close() that already waits for the cart.
+TYPED_TEST(multiple_item_cart_close_queue, close_while_last_cart_is_published)
+{
+    using value_type = int;
+
+    size_t const round_count = 2000u;
+
+    for (size_t round = 0u; round < round_count; ++round)
+    {
+        TypeParam queue{{.slots = 1, .carts = 2, .capacity = 1}};
+
+        std::atomic<size_t> dequeued_count{};
+
+        std::thread dequeue_thread{[&queue, &dequeued_count]
+                                   {
+                                       for (cart_future_t<TypeParam> cart = queue.dequeue(); cart.valid();
+                                            cart = queue.dequeue())
+                                           dequeued_count += cart.get().second.size();
+                                   }};
+
+        bool enqueued{false};
+        std::thread enqueue_thread{[&queue, &enqueued]
+                                   {
+                                       try
+                                       {
+                                           queue.enqueue(scq::slot_id{0}, value_type{1});
+                                           enqueued = true;
+                                       }
+                                       catch (std::overflow_error const &) // the queue was closed first
+                                       {}
+                                   }};
+
+        queue.close();
+
+        enqueue_thread.join();
+        dequeue_thread.join();
+
+        ASSERT_EQ(dequeued_count.load(), enqueued ? 1u : 0u) << "round " << round;
+    }
+}
@@ -5,6 +5,7 @@
 #include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
 
 #include <algorithm>        // for generate
+#include <chrono>           // for milliseconds
 #include <cstddef>          // for size_t
 #include <initializer_list> // for initializer_list
 #include <string>           // for basic_string
@@ -14,18 +15,27 @@
 
 #include <scq/slotted_cart_queue.hpp> // for slotted_cart_queue, slot_id, span, atomic_size_t, cart_capacity
 
+#include "../atomic_count.hpp"              // for atomic_count
 #include "../concurrent_cross_off_list.hpp" // for concurrent_cross_off_list
+#include "../slotted_cart_queue_types.hpp"  // for slotted_cart_queue_types, slotted_cart_queue_type_names, cart_futu...
 
 static constexpr size_t max_iterations = 55555;
 
-TEST(multiple_item_cart_concurrent_integration, multiple_producer_multiple_consumer)
+template <typename queue_t>
+class multiple_item_cart_concurrent_integration : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(multiple_item_cart_concurrent_integration,
+                 slotted_cart_queue_types<int>, slotted_cart_queue_type_names);
+
+TYPED_TEST(multiple_item_cart_concurrent_integration, multiple_producer_multiple_consumer)
 {
     using value_type = int;
 
     static constexpr size_t slot_count{5};
     static constexpr size_t cart_capacity{8};
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = slot_count, .carts = 10, .capacity = cart_capacity}};
+    TypeParam queue{{.slots = slot_count, .carts = 10, .capacity = cart_capacity}};
 
     static constexpr size_t expected_full_cart_count = (max_iterations / cart_capacity) * slot_count;
     static constexpr size_t expected_non_full_cart_count = slot_count;
@@ -72,7 +82,7 @@ TEST(multiple_item_cart_concurrent_integration, multiple_producer_multiple_consu
 
                               while (true)
                               {
-                                  scq::cart_future<value_type> cart = queue.dequeue(); // might block
+                                  cart_future_t<TypeParam> cart = queue.dequeue(); // might block
 
                                   if (!cart.valid())
                                   {
@@ -125,3 +135,147 @@ TEST(multiple_item_cart_concurrent_integration, multiple_producer_multiple_consu
     // all results seen
     EXPECT_TRUE(expected.empty());
 }
+
+TYPED_TEST(multiple_item_cart_concurrent_integration, multiple_producer_multiple_consumer_single_slot)
+{
+    using value_type = int;
+
+    static constexpr size_t producer_count{5};
+    static constexpr size_t cart_capacity{8};
+
+    // all producers share the same slot
+    TypeParam queue{{.slots = 2, .carts = 4, .capacity = cart_capacity}};
+
+    static constexpr size_t expected_full_cart_count = (max_iterations * producer_count) / cart_capacity;
+    static constexpr size_t expected_non_full_cart_count = (max_iterations * producer_count) % cart_capacity != 0;
+
+    // expected set contains all (expected) results; after the test which set should be empty (each matching result will
+    // be crossed out)
+    concurrent_cross_off_list<value_type> expected{};
+    for (size_t thread_id = 0; thread_id < producer_count; ++thread_id)
+        for (size_t i = 0; i < max_iterations; ++i)
+            expected.insert(static_cast<value_type>(thread_id * max_iterations + i));
+
+    std::vector<std::thread> enqueue_threads{};
+    for (size_t thread_id = 0; thread_id < producer_count; ++thread_id)
+    {
+        enqueue_threads.emplace_back(
+            [thread_id, &queue]
+            {
+                for (size_t i = 0; i < max_iterations; ++i)
+                    queue.enqueue(scq::slot_id{1}, static_cast<value_type>(thread_id * max_iterations + i));
+            });
+    }
+
+    std::atomic_size_t full_cart_count{};
+    std::atomic_size_t non_full_cart_count{};
+
+    std::vector<std::thread> dequeue_threads{};
+    for (size_t thread_id = 0; thread_id < 5; ++thread_id)
+    {
+        dequeue_threads.emplace_back(
+            [&queue, &expected, &full_cart_count, &non_full_cart_count]
+            {
+                std::vector<value_type> results{};
+
+                while (true)
+                {
+                    cart_future_t<TypeParam> cart = queue.dequeue(); // might block
+
+                    if (!cart.valid())
+                        break;
+
+                    std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+
+                    EXPECT_EQ(cart_data.first.value, 1u);
+
+                    full_cart_count += cart_data.second.size() == cart_capacity;
+                    non_full_cart_count += cart_data.second.size() != cart_capacity;
+
+                    results.insert(results.end(), cart_data.second.begin(), cart_data.second.end());
+                }
+
+                // cross off results after enqueue / dequeue is done
+                for (auto && result : results)
+                {
+                    EXPECT_TRUE(expected.cross_off(result));
+                }
+            });
+    }
+
+    for (auto && enqueue_thread : enqueue_threads)
+        enqueue_thread.join();
+
+    queue.close();
+
+    for (auto && dequeue_thread : dequeue_threads)
+        dequeue_thread.join();
+
+    EXPECT_EQ(full_cart_count.load(), expected_full_cart_count);
+    EXPECT_EQ(non_full_cart_count.load(), expected_non_full_cart_count);
+
+    // all results seen
+    EXPECT_TRUE(expected.empty());
+}
+
+TYPED_TEST(multiple_item_cart_concurrent_integration, close_while_enqueueing)
+{
+    using value_type = int;
+
+    static constexpr size_t producer_count{5};
+
+    TypeParam queue{{.slots = 2, .carts = 4, .capacity = 8}};
+
+    // each producer enqueues until the queue is closed; every accepted element must be dequeued exactly once
+    std::vector<size_t> accepted_counts(producer_count);
+    atomic_count started_count{};
+
+    std::vector<std::thread> enqueue_threads{};
+    for (size_t thread_id = 0; thread_id < producer_count; ++thread_id)
+    {
+        enqueue_threads.emplace_back(
+            [thread_id, &queue, &accepted_counts, &started_count]
+            {
+                ++started_count;
+
+                try
+                {
+                    for (size_t i = 0;; ++i)
+                    {
+                        queue.enqueue(scq::slot_id{thread_id % 2}, static_cast<value_type>(thread_id));
+                        accepted_counts[thread_id] = i + 1;
+                    }
+                }
+                catch (std::overflow_error const &)
+                {}
+            });
+    }
+
+    std::vector<size_t> dequeued_counts(producer_count);
+
+    std::thread dequeue_thread{[&queue, &dequeued_counts]
+                               {
+                                   while (true)
+                                   {
+                                       cart_future_t<TypeParam> cart = queue.dequeue(); // might block
+
+                                       if (!cart.valid())
+                                           break;
+
+                                       for (value_type value : cart.get().second)
+                                           ++dequeued_counts[value];
+                                   }
+                               }};
+
+    started_count.wait_at_least(producer_count);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    queue.close();
+
+    for (auto && enqueue_thread : enqueue_threads)
+        enqueue_thread.join();
+
+    dequeue_thread.join();
+
+    EXPECT_EQ(accepted_counts, dequeued_counts);
+}
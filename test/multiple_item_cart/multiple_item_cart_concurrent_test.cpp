@@ -16,14 +16,21 @@
 #include <scq/slotted_cart_queue.hpp> // for slot_id, slotted_cart_queue, span, cart_future, cart_capacity
 
 #include "../concurrent_cross_off_list.hpp" // for concurrent_cross_off_list
+#include "../slotted_cart_queue_types.hpp"  // for slotted_cart_queue_types, slotted_cart_queue_type_names, cart_futu...
 
 static constexpr std::chrono::milliseconds wait_time(10);
 
-TEST(multiple_item_cart_concurrent, single_producer_single_consumer)
+template <typename queue_t>
+class multiple_item_cart_concurrent : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(multiple_item_cart_concurrent, slotted_cart_queue_types<int>, slotted_cart_queue_type_names);
+
+TYPED_TEST(multiple_item_cart_concurrent, single_producer_single_consumer)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -51,7 +58,7 @@ TEST(multiple_item_cart_concurrent, single_producer_single_consumer)
 
     for (int i = 0; i < 6 / 2; ++i)
     {
-        scq::cart_future<value_type> cart = queue.dequeue(); // might block
+        cart_future_t<TypeParam> cart = queue.dequeue(); // might block
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -69,11 +76,11 @@ TEST(multiple_item_cart_concurrent, single_producer_single_consumer)
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(multiple_item_cart_concurrent, single_producer_multiple_consumer)
+TYPED_TEST(multiple_item_cart_concurrent, single_producer_multiple_consumer)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -108,7 +115,7 @@ TEST(multiple_item_cart_concurrent, single_producer_multiple_consumer)
                       return std::thread(
                           [&queue, &expected]
                           {
-                              scq::cart_future<value_type> cart = queue.dequeue(); // might block
+                              cart_future_t<TypeParam> cart = queue.dequeue(); // might block
                               EXPECT_TRUE(cart.valid());
                               std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -130,11 +137,11 @@ TEST(multiple_item_cart_concurrent, single_producer_multiple_consumer)
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(multiple_item_cart_concurrent, multiple_producer_single_consumer)
+TYPED_TEST(multiple_item_cart_concurrent, multiple_producer_single_consumer)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -184,7 +191,7 @@ TEST(multiple_item_cart_concurrent, multiple_producer_single_consumer)
 
     for (int i = 0; i < 6 / 2; ++i)
     {
-        scq::cart_future<value_type> cart = queue.dequeue(); // might block
+        cart_future_t<TypeParam> cart = queue.dequeue(); // might block
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -203,11 +210,11 @@ TEST(multiple_item_cart_concurrent, multiple_producer_single_consumer)
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(multiple_item_cart_concurrent, multiple_producer_multiple_consumer)
+TYPED_TEST(multiple_item_cart_concurrent, multiple_producer_multiple_consumer)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -264,7 +271,7 @@ TEST(multiple_item_cart_concurrent, multiple_producer_multiple_consumer)
                       return std::thread(
                           [&queue, &expected]
                           {
-                              scq::cart_future<value_type> cart = queue.dequeue(); // might block
+                              cart_future_t<TypeParam> cart = queue.dequeue(); // might block
                               EXPECT_TRUE(cart.valid());
                               std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
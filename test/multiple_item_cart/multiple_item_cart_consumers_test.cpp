@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <atomic>    // for atomic
+#include <cstddef>   // for size_t
+#include <stdexcept> // for logic_error, runtime_error
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, consumers
+
+TEST(multiple_item_cart_consumers, process_all_carts)
+{
+    using value_type = size_t;
+
+    size_t const slot_count = 5u;
+    size_t const producer_count = 4u;
+    size_t const values_per_producer = 5000u;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = slot_count, .carts = 10, .capacity = 4}};
+
+    std::atomic<size_t> value_sum{};
+    std::atomic<size_t> value_count{};
+
+    queue.start_consumers(scq::consumers{3},
+                          [&value_sum, &value_count](scq::slot_id slot, std::span<value_type> memory_region)
+                          {
+                              EXPECT_GE(memory_region.size(), 1u);
+                              EXPECT_LE(memory_region.size(), 4u);
+
+                              for (value_type value : memory_region)
+                              {
+                                  EXPECT_EQ(value % slot_count, slot.value);
+                                  value_sum += value;
+                                  ++value_count;
+                              }
+                          });
+
+    std::vector<std::thread> producers{};
+    for (size_t producer_id = 0u; producer_id < producer_count; ++producer_id)
+    {
+        producers.emplace_back(
+            [&queue, producer_id]()
+            {
+                for (size_t i = 0u; i < values_per_producer; ++i)
+                {
+                    size_t const value = producer_id * values_per_producer + i;
+                    queue.enqueue(scq::slot_id{value % slot_count}, value);
+                }
+            });
+    }
+
+    for (std::thread & producer : producers)
+        producer.join();
+
+    queue.close();
+    queue.join_consumers();
+
+    size_t const total_count = producer_count * values_per_producer;
+    EXPECT_EQ(value_count.load(), total_count);
+    EXPECT_EQ(value_sum.load(), total_count * (total_count - 1u) / 2u);
+}
+
+TEST(multiple_item_cart_consumers, handler_exception)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+
+    std::atomic<size_t> processed_count{};
+
+    queue.start_consumers(scq::consumers{2},
+                          [&processed_count](scq::slot_id slot, std::span<value_type>)
+                          {
+                              if (slot.value == 3u)
+                                  throw std::runtime_error{"slot 3"};
+
+                              ++processed_count;
+                          });
+
+    // more values than carts, i.e. the carts of the throwing handler must have been returned
+    for (size_t i = 0u; i < 20u; ++i)
+        queue.enqueue(scq::slot_id{i % 5u}, static_cast<value_type>(i));
+
+    queue.close();
+    EXPECT_THROW(queue.join_consumers(), std::runtime_error);
+    EXPECT_EQ(processed_count.load(), 16u);
+
+    // the exception is only rethrown once
+    EXPECT_NO_THROW(queue.join_consumers());
+}
+
+TEST(multiple_item_cart_consumers, destructor_closes_queue)
+{
+    using value_type = int;
+
+    std::atomic<size_t> processed_count{};
+
+    {
+        scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+        queue.start_consumers(scq::consumers{2},
+                              [&processed_count](scq::slot_id, std::span<value_type> memory_region)
+                              {
+                                  processed_count += memory_region.size();
+                              });
+
+        for (value_type value = 0; value < 7; ++value)
+            queue.enqueue(scq::slot_id{1}, value);
+    }
+
+    // the partially filled cart is processed as well
+    EXPECT_EQ(processed_count.load(), 7u);
+}
+
+TEST(multiple_item_cart_consumers, invalid_arguments)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    auto handler = [](scq::slot_id, std::span<value_type>) {};
+
+    EXPECT_THROW(queue.start_consumers(scq::consumers{0}, handler), std::logic_error);
+
+    queue.start_consumers(scq::consumers{1}, handler);
+    EXPECT_THROW(queue.start_consumers(scq::consumers{1}, handler), std::logic_error);
+
+    queue.close();
+    queue.join_consumers();
+}
+
+TEST(multiple_item_cart_consumers, pinned_consumers)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+
+    std::atomic<size_t> processed_count{};
+    std::vector<size_t> const cpus{0u};
+
+    queue.start_consumers(
+        scq::consumers{2},
+        [&processed_count](scq::slot_id, std::span<value_type>)
+        {
+            ++processed_count;
+        },
+        cpus);
+
+    for (value_type value = 0; value < 10; ++value)
+        queue.enqueue(scq::slot_id{2}, value);
+
+    queue.close();
+    queue.join_consumers();
+    EXPECT_EQ(processed_count.load(), 10u);
+}
@@ -0,0 +1,378 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <atomic>             // for atomic
+#include <condition_variable> // for condition_variable
+#include <coroutine>          // for coroutine_handle, suspend_never
+#include <cstddef>            // for size_t
+#include <deque>              // for deque
+#include <exception>          // for terminate
+#include <memory>             // for shared_ptr, make_shared
+#include <mutex>              // for mutex, unique_lock
+#include <thread>             // for thread
+#include <vector>             // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, queue_op_status
+
+// A coroutine that starts right away and is not awaited.
+struct detached_task
+{
+    struct promise_type
+    {
+        detached_task get_return_object()
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void()
+        {}
+
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+};
+
+// Collects the coroutines to resume, run resumes them on the calling thread.
+struct manual_executor
+{
+    void operator()(std::coroutine_handle<> handle) const
+    {
+        handles->push_back(handle);
+    }
+
+    size_t run() const
+    {
+        size_t resumed_count{};
+
+        while (!handles->empty())
+        {
+            std::coroutine_handle<> handle = handles->front();
+            handles->pop_front();
+            handle.resume();
+            ++resumed_count;
+        }
+
+        return resumed_count;
+    }
+
+    std::shared_ptr<std::deque<std::coroutine_handle<>>> handles{
+        std::make_shared<std::deque<std::coroutine_handle<>>>()};
+};
+
+// Resumes the coroutines on a fixed number of threads.
+class thread_pool
+{
+public:
+    explicit thread_pool(size_t thread_count)
+    {
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back(
+                [this]
+                {
+                    std::unique_lock<std::mutex> lock{mutex};
+
+                    while (true)
+                    {
+                        cv.wait(lock,
+                                [this]
+                                {
+                                    return !handles.empty() || stopped;
+                                });
+
+                        if (handles.empty())
+                            return;
+
+                        std::coroutine_handle<> handle = handles.front();
+                        handles.pop_front();
+
+                        lock.unlock();
+                        handle.resume();
+                        lock.lock();
+                    }
+                });
+        }
+    }
+
+    ~thread_pool()
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            stopped = true;
+        }
+
+        cv.notify_all();
+
+        for (std::thread & thread : threads)
+            thread.join();
+    }
+
+    struct executor
+    {
+        void operator()(std::coroutine_handle<> handle) const
+        {
+            {
+                std::unique_lock<std::mutex> lock{pool->mutex};
+                pool->handles.push_back(handle);
+            }
+
+            pool->cv.notify_one();
+        }
+
+        thread_pool * pool;
+    };
+
+    executor get_executor()
+    {
+        return {this};
+    }
+
+private:
+    std::mutex mutex{};
+    std::condition_variable cv{};
+    std::deque<std::coroutine_handle<>> handles{};
+    bool stopped{false};
+    std::vector<std::thread> threads{};
+};
+
+TEST(multiple_item_cart_coroutine, async_dequeue_suspends_until_cart_is_full)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    manual_executor executor{};
+
+    std::vector<value_type> values{};
+    bool done{false};
+
+    auto consumer = [&]() -> detached_task
+    {
+        scq::cart_future<value_type> cart = co_await queue.async_dequeue(executor);
+        EXPECT_TRUE(cart.valid());
+
+        auto [slot, memory_region] = cart.get();
+        EXPECT_EQ(slot.value, 1u);
+        values.assign(memory_region.begin(), memory_region.end());
+        done = true;
+    };
+
+    consumer();
+    EXPECT_EQ(executor.run(), 0u);
+
+    queue.enqueue(scq::slot_id{1}, 100);
+    EXPECT_EQ(executor.run(), 0u);
+    EXPECT_FALSE(done);
+
+    // the full cart is handed over to the suspended consumer
+    queue.enqueue(scq::slot_id{1}, 101);
+    EXPECT_FALSE(done);
+    EXPECT_EQ(executor.run(), 1u);
+    EXPECT_TRUE(done);
+    EXPECT_EQ(values, (std::vector<value_type>{100, 101}));
+
+    // the cart was processed
+    queue.enqueue(scq::slot_id{2}, 200);
+    queue.enqueue(scq::slot_id{2}, 201);
+    EXPECT_TRUE(queue.dequeue().valid());
+}
+
+TEST(multiple_item_cart_coroutine, async_dequeue_without_suspending)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    queue.enqueue(scq::slot_id{1}, 100);
+
+    bool done{false};
+
+    auto consumer = [&]() -> detached_task
+    {
+        scq::cart_future<value_type> cart = co_await queue.async_dequeue();
+        EXPECT_EQ(cart.get().second[0], 100);
+        done = true;
+    };
+
+    consumer();
+    EXPECT_TRUE(done);
+}
+
+TEST(multiple_item_cart_coroutine, close_resumes_async_consumers)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    manual_executor executor{};
+
+    size_t invalid_count{};
+
+    auto consumer = [&]() -> detached_task
+    {
+        while (true)
+        {
+            scq::cart_future<value_type> cart = co_await queue.async_dequeue(executor);
+
+            if (!cart.valid())
+                break;
+
+            EXPECT_EQ(cart.get().second.size(), 1u);
+        }
+
+        ++invalid_count;
+    };
+
+    consumer();
+    consumer();
+
+    queue.enqueue(scq::slot_id{1}, 100);
+    queue.close();
+
+    executor.run();
+    EXPECT_EQ(invalid_count, 2u);
+}
+
+TEST(multiple_item_cart_coroutine, async_enqueue_suspends_until_empty_cart_is_available)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 1, .carts = 1, .capacity = 1}};
+    manual_executor executor{};
+
+    queue.enqueue(scq::slot_id{0}, 100);
+
+    scq::queue_op_status status{scq::queue_op_status::would_block};
+
+    auto producer = [&]() -> detached_task
+    {
+        status = co_await queue.async_enqueue(scq::slot_id{0}, 101, executor);
+    };
+
+    producer();
+    EXPECT_EQ(executor.run(), 0u);
+    EXPECT_EQ(status, scq::queue_op_status::would_block);
+
+    {
+        scq::cart_future<value_type> cart = queue.dequeue();
+        EXPECT_EQ(cart.get().second[0], 100);
+    }
+
+    // the value was enqueued by the thread that returned the empty cart
+    EXPECT_EQ(executor.run(), 1u);
+    EXPECT_EQ(status, scq::queue_op_status::ok);
+
+    scq::cart_future<value_type> cart = queue.dequeue();
+    EXPECT_EQ(cart.get().second[0], 101);
+}
+
+TEST(multiple_item_cart_coroutine, close_resumes_async_producers)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 1, .carts = 1, .capacity = 1}};
+    manual_executor executor{};
+
+    queue.enqueue(scq::slot_id{0}, 100);
+
+    scq::queue_op_status status{scq::queue_op_status::would_block};
+
+    auto producer = [&]() -> detached_task
+    {
+        status = co_await queue.async_enqueue(scq::slot_id{0}, 101, executor);
+    };
+
+    producer();
+    queue.close();
+
+    EXPECT_EQ(executor.run(), 1u);
+    EXPECT_EQ(status, scq::queue_op_status::closed);
+}
+
+TEST(multiple_item_cart_coroutine, concurrent)
+{
+    using value_type = size_t;
+
+    size_t const slot_count = 4u;
+    size_t const producer_count = 4u;
+    size_t const consumer_count = 3u;
+    size_t const values_per_producer = 2000u;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = slot_count, .carts = 6, .capacity = 3}};
+
+    std::atomic<size_t> running_producers{producer_count};
+    std::atomic<size_t> running_consumers{consumer_count};
+    std::atomic<size_t> value_sum{};
+    std::atomic<size_t> value_count{};
+
+    {
+        thread_pool pool{4u};
+        thread_pool::executor executor = pool.get_executor();
+
+        auto producer = [&](size_t producer_id) -> detached_task
+        {
+            for (size_t i = 0u; i < values_per_producer; ++i)
+            {
+                size_t const value = producer_id * values_per_producer + i;
+                scq::queue_op_status status =
+                    co_await queue.async_enqueue(scq::slot_id{value % slot_count}, value, executor);
+                EXPECT_EQ(status, scq::queue_op_status::ok);
+            }
+
+            running_producers.fetch_sub(1u);
+            running_producers.notify_all();
+        };
+
+        auto consumer = [&]() -> detached_task
+        {
+            while (true)
+            {
+                scq::cart_future<value_type> cart = co_await queue.async_dequeue(executor);
+
+                if (!cart.valid())
+                    break;
+
+                auto [slot, memory_region] = cart.get();
+                for (value_type value : memory_region)
+                {
+                    EXPECT_EQ(value % slot_count, slot.value);
+                    value_sum += value;
+                    ++value_count;
+                }
+            }
+
+            running_consumers.fetch_sub(1u);
+            running_consumers.notify_all();
+        };
+
+        for (size_t consumer_id = 0u; consumer_id < consumer_count; ++consumer_id)
+            consumer();
+
+        for (size_t producer_id = 0u; producer_id < producer_count; ++producer_id)
+            producer(producer_id);
+
+        for (size_t count = running_producers.load(); count != 0u; count = running_producers.load())
+            running_producers.wait(count);
+
+        queue.close();
+
+        for (size_t count = running_consumers.load(); count != 0u; count = running_consumers.load())
+            running_consumers.wait(count);
+    }
+
+    size_t const total_count = producer_count * values_per_producer;
+    EXPECT_EQ(value_count.load(), total_count);
+    EXPECT_EQ(value_sum.load(), total_count * (total_count - 1u) / 2u);
+}
@@ -0,0 +1,173 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <algorithm> // for sort
+#include <cstddef>   // for size_t
+#include <future>    // for future_error
+#include <memory>    // for shared_ptr, make_shared
+#include <numeric>   // for iota
+#include <stdexcept> // for logic_error
+#include <thread>    // for thread
+#include <utility>   // for move
+#include <vector>    // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_batch
+
+TEST(multiple_item_cart_dequeue_batch, dequeue_up_to_max_count)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    for (value_type value : {100, 101, 200, 201, 300, 301})
+        queue.enqueue(scq::slot_id{static_cast<size_t>(value / 100)}, value);
+
+    std::vector<value_type> values{};
+
+    {
+        scq::cart_batch<value_type> batch = queue.dequeue_batch(2u);
+        EXPECT_TRUE(batch.valid());
+        EXPECT_EQ(batch.get().size(), 2u);
+
+        for (auto && [slot, memory_region] : batch.get())
+        {
+            EXPECT_EQ(memory_region.size(), 2u);
+            EXPECT_EQ(static_cast<size_t>(memory_region[0] / 100), slot.value);
+            values.insert(values.end(), memory_region.begin(), memory_region.end());
+        }
+    }
+
+    {
+        // only one full cart is left
+        scq::cart_batch<value_type> batch = queue.dequeue_batch(2u);
+        EXPECT_EQ(batch.get().size(), 1u);
+        values.insert(values.end(), batch.get()[0].second.begin(), batch.get()[0].second.end());
+    }
+
+    std::ranges::sort(values);
+    EXPECT_EQ(values, (std::vector<value_type>{100, 101, 200, 201, 300, 301}));
+
+    EXPECT_THROW((void)queue.dequeue_batch(0u), std::logic_error);
+}
+
+TEST(multiple_item_cart_dequeue_batch, dequeue_after_close)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    queue.enqueue(scq::slot_id{1}, 100);
+    queue.enqueue(scq::slot_id{2}, 200);
+    queue.close();
+
+    scq::cart_batch<value_type> batch = queue.dequeue_batch(5u);
+    EXPECT_TRUE(batch.valid());
+    EXPECT_EQ(batch.get().size(), 2u);
+
+    scq::cart_batch<value_type> empty_batch = queue.dequeue_batch(5u);
+    EXPECT_FALSE(empty_batch.valid());
+    EXPECT_THROW(empty_batch.get(), std::future_error);
+}
+
+TEST(multiple_item_cart_dequeue_batch, carts_are_returned_with_batch)
+{
+    using value_type = std::shared_ptr<int>;
+
+    value_type value = std::make_shared<int>(1);
+
+    // all carts are in use
+    scq::slotted_cart_queue<value_type> queue{{.slots = 2, .carts = 2, .capacity = 1}};
+    queue.enqueue(scq::slot_id{0}, value);
+    queue.enqueue(scq::slot_id{1}, value);
+
+    scq::cart_batch<value_type> batch = queue.dequeue_batch(2u);
+    EXPECT_EQ(batch.get().size(), 2u);
+    EXPECT_EQ(value.use_count(), 3);
+
+    // a moved-from batch does not return the carts
+    scq::cart_batch<value_type> moved_batch{std::move(batch)};
+    EXPECT_FALSE(batch.valid());
+    EXPECT_EQ(value.use_count(), 3);
+
+    moved_batch = scq::cart_batch<value_type>{};
+    EXPECT_EQ(value.use_count(), 1);
+
+    // both carts are empty again
+    queue.enqueue(scq::slot_id{0}, value);
+    queue.enqueue(scq::slot_id{1}, value);
+    EXPECT_EQ(queue.dequeue_batch(2u).get().size(), 2u);
+}
+
+TEST(multiple_item_cart_dequeue_batch, concurrent)
+{
+    using value_type = size_t;
+
+    size_t const slot_count = 4u;
+    size_t const producer_count = 4u;
+    size_t const consumer_count = 3u;
+    size_t const values_per_producer = 2000u;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = slot_count, .carts = 8, .capacity = 3}};
+
+    std::vector<std::thread> producers{};
+    for (size_t producer = 0u; producer < producer_count; ++producer)
+    {
+        producers.emplace_back(
+            [&queue, producer]()
+            {
+                for (size_t i = 0u; i < values_per_producer; ++i)
+                {
+                    size_t const value = producer * values_per_producer + i;
+                    queue.enqueue(scq::slot_id{value % slot_count}, value);
+                }
+            });
+    }
+
+    std::vector<std::vector<value_type>> dequeued_values(consumer_count);
+    std::vector<std::thread> consumers{};
+    for (size_t consumer = 0u; consumer < consumer_count; ++consumer)
+    {
+        consumers.emplace_back(
+            [&queue, &values = dequeued_values[consumer]]()
+            {
+                while (true)
+                {
+                    // the previous batch is returned before the next one is dequeued
+                    scq::cart_batch<value_type> batch = queue.dequeue_batch(3u);
+
+                    if (!batch.valid())
+                        break;
+
+                    for (auto && [slot, memory_region] : batch.get())
+                    {
+                        for (value_type value : memory_region)
+                        {
+                            EXPECT_EQ(value % slot_count, slot.value);
+                            values.push_back(value);
+                        }
+                    }
+                }
+            });
+    }
+
+    for (std::thread & producer : producers)
+        producer.join();
+
+    queue.close();
+
+    for (std::thread & consumer : consumers)
+        consumer.join();
+
+    std::vector<value_type> all_values{};
+    for (std::vector<value_type> & values : dequeued_values)
+        all_values.insert(all_values.end(), values.begin(), values.end());
+
+    std::vector<value_type> expected_values(producer_count * values_per_producer);
+    std::iota(expected_values.begin(), expected_values.end(), 0u);
+
+    std::ranges::sort(all_values);
+    EXPECT_EQ(all_values, expected_values);
+}
@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <algorithm> // for sort
+#include <cstddef>   // for size_t
+#include <memory>    // for shared_ptr, make_shared
+#include <numeric>   // for iota
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_batch, cart_order
+
+// Dequeues coalesced batches until the queue is drained; returns the first value of each cart per batch.
+static std::vector<std::vector<int>> dequeue_all_coalesced(scq::slotted_cart_queue<int> & queue)
+{
+    std::vector<std::vector<int>> batches{};
+
+    while (true)
+    {
+        scq::cart_batch<int> batch = queue.dequeue_coalesced();
+
+        if (!batch.valid())
+            break;
+
+        std::vector<int> & values = batches.emplace_back();
+        for (auto && [slot, memory_region] : batch.get())
+        {
+            EXPECT_EQ(slot.value, batch.get()[0].first.value);
+            values.push_back(memory_region[0]);
+        }
+    }
+
+    return batches;
+}
+
+TEST(multiple_item_cart_dequeue_coalesced, coalesce_carts_of_slot)
+{
+    for (scq::cart_order cart_order : {scq::cart_order::lifo, scq::cart_order::fifo, scq::cart_order::round_robin})
+    {
+        scq::slotted_cart_queue<int> queue{{.slots = 3, .carts = 8, .capacity = 1, .cart_order = cart_order}};
+
+        for (int value : {0, 100, 1, 200, 2, 101})
+            queue.enqueue(scq::slot_id{static_cast<size_t>(value / 100)}, value);
+
+        queue.close();
+
+        std::vector<std::vector<int>> batches = dequeue_all_coalesced(queue);
+        for (std::vector<int> & values : batches)
+            std::ranges::sort(values);
+        std::ranges::sort(batches);
+
+        EXPECT_EQ(batches, (std::vector<std::vector<int>>{{0, 1, 2}, {100, 101}, {200}}));
+    }
+}
+
+TEST(multiple_item_cart_dequeue_coalesced, order_of_slots)
+{
+    scq::slotted_cart_queue<int> queue{
+        {.slots = 3, .carts = 8, .capacity = 1, .cart_order = scq::cart_order::fifo}};
+
+    for (int value : {100, 0, 101, 200, 1})
+        queue.enqueue(scq::slot_id{static_cast<size_t>(value / 100)}, value);
+
+    queue.close();
+
+    // the slot of the next cart in order is coalesced, the carts keep their order
+    EXPECT_EQ(dequeue_all_coalesced(queue), (std::vector<std::vector<int>>{{100, 101}, {0, 1}, {200}}));
+}
+
+TEST(multiple_item_cart_dequeue_coalesced, exclusive_slots)
+{
+    scq::slotted_cart_queue<int> queue{
+        {.slots = 3, .carts = 8, .capacity = 1, .cart_order = scq::cart_order::fifo, .exclusive_slots = true}};
+
+    for (int value : {0, 1, 100, 2})
+        queue.enqueue(scq::slot_id{static_cast<size_t>(value / 100)}, value);
+
+    {
+        // includes the held back carts of the slot
+        scq::cart_batch<int> batch = queue.dequeue_coalesced();
+        EXPECT_EQ(batch.get().size(), 3u);
+
+        queue.enqueue(scq::slot_id{0}, 3);
+
+        scq::cart_batch<int> other_batch = queue.dequeue_coalesced();
+        EXPECT_EQ(other_batch.get().size(), 1u);
+        EXPECT_EQ(other_batch.get()[0].first.value, 1u);
+    }
+
+    // the slot was released once by the batch
+    scq::cart_batch<int> batch = queue.dequeue_coalesced();
+    EXPECT_EQ(batch.get().size(), 1u);
+    EXPECT_EQ(batch.get()[0].second[0], 3);
+}
+
+TEST(multiple_item_cart_dequeue_coalesced, carts_are_returned_with_batch)
+{
+    using value_type = std::shared_ptr<int>;
+
+    value_type value = std::make_shared<int>(1);
+
+    // all carts are in use
+    scq::slotted_cart_queue<value_type> queue{{.slots = 2, .carts = 3, .capacity = 1}};
+    for (size_t slot : {0u, 1u, 0u})
+        queue.enqueue(scq::slot_id{slot}, value);
+
+    {
+        scq::cart_batch<value_type> batch = queue.dequeue_coalesced();
+        EXPECT_EQ(batch.get().size(), 2u);
+        EXPECT_EQ(value.use_count(), 4);
+    }
+
+    EXPECT_EQ(value.use_count(), 2);
+
+    queue.enqueue(scq::slot_id{0}, value);
+    queue.enqueue(scq::slot_id{0}, value);
+    EXPECT_EQ(queue.dequeue_coalesced().get().size(), 2u);
+}
+
+TEST(multiple_item_cart_dequeue_coalesced, concurrent)
+{
+    using value_type = size_t;
+
+    size_t const slot_count = 4u;
+    size_t const producer_count = 4u;
+    size_t const consumer_count = 3u;
+    size_t const values_per_producer = 2000u;
+
+    for (scq::cart_order cart_order : {scq::cart_order::lifo, scq::cart_order::fifo, scq::cart_order::round_robin})
+    {
+        scq::slotted_cart_queue<value_type> queue{
+            {.slots = slot_count, .carts = 16, .capacity = 3, .cart_order = cart_order, .partitions = 2}};
+
+        std::vector<std::thread> producers{};
+        for (size_t producer = 0u; producer < producer_count; ++producer)
+        {
+            producers.emplace_back(
+                [&queue, producer]()
+                {
+                    for (size_t i = 0u; i < values_per_producer; ++i)
+                    {
+                        size_t const value = producer * values_per_producer + i;
+                        queue.enqueue(scq::slot_id{value % slot_count}, value);
+                    }
+                });
+        }
+
+        std::vector<std::vector<value_type>> dequeued_values(consumer_count);
+        std::vector<std::thread> consumers{};
+        for (size_t consumer = 0u; consumer < consumer_count; ++consumer)
+        {
+            consumers.emplace_back(
+                [&queue, &values = dequeued_values[consumer]]()
+                {
+                    while (true)
+                    {
+                        scq::cart_batch<value_type> batch = queue.dequeue_coalesced();
+
+                        if (!batch.valid())
+                            break;
+
+                        for (auto && [slot, memory_region] : batch.get())
+                        {
+                            EXPECT_EQ(slot.value, batch.get()[0].first.value);
+
+                            for (value_type value : memory_region)
+                            {
+                                EXPECT_EQ(value % slot_count, slot.value);
+                                values.push_back(value);
+                            }
+                        }
+                    }
+                });
+        }
+
+        for (std::thread & producer : producers)
+            producer.join();
+
+        queue.close();
+
+        for (std::thread & consumer : consumers)
+            consumer.join();
+
+        std::vector<value_type> all_values{};
+        for (std::vector<value_type> & values : dequeued_values)
+            all_values.insert(all_values.end(), values.begin(), values.end());
+
+        std::vector<value_type> expected_values(producer_count * values_per_producer);
+        std::iota(expected_values.begin(), expected_values.end(), 0u);
+
+        std::ranges::sort(all_values);
+        EXPECT_EQ(all_values, expected_values);
+    }
+}
@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <cstddef>     // for size_t
+#include <stdexcept>   // for invalid_argument, overflow_error
+#include <string_view> // for string_view
+#include <utility>     // for pair
+#include <vector>      // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, cart_capacity
+
+// Is not default constructible and counts its constructions and destructions.
+struct record
+{
+    record(int id, std::string_view name) noexcept : id{id}, name{name}
+    {
+        ++constructed_count;
+    }
+
+    record(record const & other) : id{other.id}, name{other.name}
+    {
+        ++constructed_count;
+        ++copied_count;
+    }
+
+    record(record && other) noexcept : id{other.id}, name{other.name}
+    {
+        ++constructed_count;
+        ++moved_count;
+    }
+
+    ~record()
+    {
+        ++destructed_count;
+    }
+
+    static void reset_counts()
+    {
+        constructed_count = 0u;
+        copied_count = 0u;
+        moved_count = 0u;
+        destructed_count = 0u;
+    }
+
+    int id;
+    std::string_view name;
+
+    static inline size_t constructed_count{};
+    static inline size_t copied_count{};
+    static inline size_t moved_count{};
+    static inline size_t destructed_count{};
+};
+
+// The construction throws for negative ids.
+struct throwing_record
+{
+    throwing_record(int id) : id{id}
+    {
+        if (id < 0)
+            throw std::invalid_argument{"negative id"};
+    }
+
+    throwing_record(throwing_record &&) noexcept = default;
+
+    int id;
+};
+
+TEST(multiple_item_cart_emplace, constructs_in_place)
+{
+    using value_type = record;
+
+    record::reset_counts();
+
+    {
+        scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+        queue.emplace(scq::slot_id{1}, 100, "hundred");
+        queue.emplace(scq::slot_id{1}, 101, "hundred and one");
+
+        // neither copies nor moves
+        EXPECT_EQ(record::constructed_count, 2u);
+        EXPECT_EQ(record::copied_count, 0u);
+        EXPECT_EQ(record::moved_count, 0u);
+
+        {
+            scq::cart_future<value_type> cart = queue.dequeue();
+            EXPECT_TRUE(cart.valid());
+            std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+
+            EXPECT_EQ(cart_data.first.value, 1u);
+            EXPECT_EQ(cart_data.second.size(), 2u);
+            EXPECT_EQ(cart_data.second[0].id, 100);
+            EXPECT_EQ(cart_data.second[0].name, "hundred");
+            EXPECT_EQ(cart_data.second[1].id, 101);
+            EXPECT_EQ(cart_data.second[1].name, "hundred and one");
+
+            EXPECT_EQ(record::destructed_count, 0u);
+        }
+
+        // the elements are destroyed once the cart was processed
+        EXPECT_EQ(record::destructed_count, 2u);
+    }
+
+    EXPECT_EQ(record::constructed_count, 2u);
+    EXPECT_EQ(record::destructed_count, 2u);
+}
+
+TEST(multiple_item_cart_emplace, enqueue_moves_value)
+{
+    using value_type = record;
+
+    record::reset_counts();
+
+    {
+        scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+
+        queue.enqueue(scq::slot_id{1}, record{100, "hundred"});
+
+        EXPECT_EQ(record::copied_count, 0u);
+        EXPECT_EQ(record::moved_count, 1u);
+
+        scq::cart_future<value_type> cart = queue.dequeue();
+        EXPECT_EQ(cart.get().second[0].name, "hundred");
+    }
+
+    EXPECT_EQ(record::constructed_count, record::destructed_count);
+}
+
+TEST(multiple_item_cart_emplace, destroy_unprocessed_elements)
+{
+    using value_type = record;
+
+    record::reset_counts();
+
+    {
+        scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+        // a full cart that is never dequeued
+        queue.emplace(scq::slot_id{1}, 100, "hundred");
+        queue.emplace(scq::slot_id{1}, 101, "hundred and one");
+
+        // a half-filled cart that is never published
+        queue.emplace(scq::slot_id{2}, 200, "two hundred");
+
+        EXPECT_EQ(record::destructed_count, 0u);
+    }
+
+    EXPECT_EQ(record::constructed_count, 3u);
+    EXPECT_EQ(record::destructed_count, 3u);
+}
+
+TEST(multiple_item_cart_emplace, throwing_construction)
+{
+    using value_type = throwing_record;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    queue.emplace(scq::slot_id{1}, 100);
+    EXPECT_THROW(queue.emplace(scq::slot_id{1}, -1), std::invalid_argument);
+    queue.emplace(scq::slot_id{1}, 101);
+
+    // the failed construction did not occupy a position
+    scq::cart_future<value_type> cart = queue.dequeue();
+    EXPECT_TRUE(cart.valid());
+    std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+
+    EXPECT_EQ(cart_data.second.size(), 2u);
+    EXPECT_EQ(cart_data.second[0].id, 100);
+    EXPECT_EQ(cart_data.second[1].id, 101);
+}
+
+TEST(multiple_item_cart_emplace, emplace_after_close)
+{
+    using value_type = record;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    queue.close();
+
+    EXPECT_THROW(queue.emplace(scq::slot_id{1}, 100, "hundred"), std::overflow_error);
+}
+
+TEST(multiple_item_cart_emplace, close_publishes_half_filled_carts)
+{
+    using value_type = record;
+
+    record::reset_counts();
+
+    {
+        scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 3}};
+
+        for (int id : {100, 101, 102, 103})
+            queue.emplace(scq::slot_id{1}, id, "id");
+
+        queue.close();
+
+        std::vector<size_t> cart_sizes{};
+        for (scq::cart_future<value_type> cart = queue.dequeue(); cart.valid(); cart = queue.dequeue())
+            cart_sizes.push_back(cart.get().second.size());
+
+        EXPECT_EQ(cart_sizes.size(), 2u);
+        EXPECT_EQ(cart_sizes[0] + cart_sizes[1], 4u);
+    }
+
+    EXPECT_EQ(record::constructed_count, 4u);
+    EXPECT_EQ(record::destructed_count, 4u);
+}
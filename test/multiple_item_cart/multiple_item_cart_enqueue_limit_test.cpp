@@ -16,14 +16,21 @@
 #include <scq/slotted_cart_queue.hpp> // for slot_id, slotted_cart_queue, span, mutex, condition_variable
 
 #include "../concurrent_cross_off_list.hpp" // for concurrent_cross_off_list
+#include "../slotted_cart_queue_types.hpp"  // for slotted_cart_queue_types, slotted_cart_queue_type_names, cart_futu...
 
 static constexpr std::chrono::milliseconds wait_time(10);
 
-TEST(multiple_item_cart_enqueue_limit_test, single_producer_single_consumer_all_full_carts)
+template <typename queue_t>
+class multiple_item_cart_enqueue_limit_test : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(multiple_item_cart_enqueue_limit_test, slotted_cart_queue_types<int>, slotted_cart_queue_type_names);
+
+TYPED_TEST(multiple_item_cart_enqueue_limit_test, single_producer_single_consumer_all_full_carts)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 3, .carts = 3, .capacity = 2}};
+    TypeParam queue{{.slots = 3, .carts = 3, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -94,7 +101,7 @@ TEST(multiple_item_cart_enqueue_limit_test, single_producer_single_consumer_all_
 
     // release one full cart to allow enqueue to continue
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -113,7 +120,7 @@ TEST(multiple_item_cart_enqueue_limit_test, single_producer_single_consumer_all_
 
     for (int i = 0; i < 3; ++i)
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -129,11 +136,11 @@ TEST(multiple_item_cart_enqueue_limit_test, single_producer_single_consumer_all_
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(multiple_item_cart_enqueue_limit_test, single_producer_single_consumer_mixed_carts)
+TYPED_TEST(multiple_item_cart_enqueue_limit_test, single_producer_single_consumer_mixed_carts)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 3, .carts = 3, .capacity = 2}};
+    TypeParam queue{{.slots = 3, .carts = 3, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -204,7 +211,7 @@ TEST(multiple_item_cart_enqueue_limit_test, single_producer_single_consumer_mixe
 
     // release one full cart to allow enqueue to continue
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -224,7 +231,7 @@ TEST(multiple_item_cart_enqueue_limit_test, single_producer_single_consumer_mixe
 
     for (int i = 0; i < 3; ++i)
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -247,11 +254,11 @@ TEST(multiple_item_cart_enqueue_limit_test, single_producer_single_consumer_mixe
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(multiple_item_cart_enqueue_limit_test, single_producer_multiple_consumer_all_full_carts)
+TYPED_TEST(multiple_item_cart_enqueue_limit_test, single_producer_multiple_consumer_all_full_carts)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 3, .carts = 3, .capacity = 2}};
+    TypeParam queue{{.slots = 3, .carts = 3, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -336,7 +343,7 @@ TEST(multiple_item_cart_enqueue_limit_test, single_producer_multiple_consumer_al
                       return std::thread(
                           [&queue, &expected]
                           {
-                              scq::cart_future<value_type> cart = queue.dequeue();
+                              cart_future_t<TypeParam> cart = queue.dequeue();
                               EXPECT_TRUE(cart.valid());
                               std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -360,11 +367,11 @@ TEST(multiple_item_cart_enqueue_limit_test, single_producer_multiple_consumer_al
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(multiple_item_cart_enqueue_limit_test, single_producer_multiple_consumer_mixed_carts)
+TYPED_TEST(multiple_item_cart_enqueue_limit_test, single_producer_multiple_consumer_mixed_carts)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 3, .carts = 3, .capacity = 2}};
+    TypeParam queue{{.slots = 3, .carts = 3, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -447,7 +454,7 @@ TEST(multiple_item_cart_enqueue_limit_test, single_producer_multiple_consumer_mi
                       return std::thread(
                           [&queue, &expected, &full_cart_count, &half_filled_cart_count]
                           {
-                              scq::cart_future<value_type> cart = queue.dequeue();
+                              cart_future_t<TypeParam> cart = queue.dequeue();
                               EXPECT_TRUE(cart.valid());
                               std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -479,11 +486,11 @@ TEST(multiple_item_cart_enqueue_limit_test, single_producer_multiple_consumer_mi
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_single_consumer_all_full_carts)
+TYPED_TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_single_consumer_all_full_carts)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 3, .carts = 3, .capacity = 2}};
+    TypeParam queue{{.slots = 3, .carts = 3, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -565,7 +572,7 @@ TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_single_consumer_al
 
     // release one cart to allow enqueue to continue
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -584,7 +591,7 @@ TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_single_consumer_al
 
     for (int i = 0; i < 3; ++i)
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -600,11 +607,11 @@ TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_single_consumer_al
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_single_consumer_mixed_carts)
+TYPED_TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_single_consumer_mixed_carts)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 3, .carts = 3, .capacity = 2}};
+    TypeParam queue{{.slots = 3, .carts = 3, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -683,7 +690,7 @@ TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_single_consumer_mi
 
     // release one cart to allow enqueue to continue
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -704,7 +711,7 @@ TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_single_consumer_mi
 
     for (int i = 0; i < 3; ++i)
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -727,11 +734,11 @@ TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_single_consumer_mi
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_multiple_consumer_all_full_carts)
+TYPED_TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_multiple_consumer_all_full_carts)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 3, .carts = 3, .capacity = 2}};
+    TypeParam queue{{.slots = 3, .carts = 3, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -825,7 +832,7 @@ TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_multiple_consumer_
                       return std::thread(
                           [&queue, &expected]
                           {
-                              scq::cart_future<value_type> cart = queue.dequeue();
+                              cart_future_t<TypeParam> cart = queue.dequeue();
                               EXPECT_TRUE(cart.valid());
                               std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -850,11 +857,11 @@ TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_multiple_consumer_
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_multiple_consumer_mixed_carts)
+TYPED_TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_multiple_consumer_mixed_carts)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 3, .carts = 3, .capacity = 2}};
+    TypeParam queue{{.slots = 3, .carts = 3, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -942,7 +949,7 @@ TEST(multiple_item_cart_enqueue_limit_test, multiple_producer_multiple_consumer_
                       return std::thread(
                           [&queue, &expected, &full_cart_count, &half_filled_cart_count]
                           {
-                              scq::cart_future<value_type> cart = queue.dequeue();
+                              cart_future_t<TypeParam> cart = queue.dequeue();
                               EXPECT_TRUE(cart.valid());
                               std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
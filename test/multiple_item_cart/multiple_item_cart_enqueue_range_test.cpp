@@ -0,0 +1,264 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <chrono>   // for milliseconds
+#include <cstddef>  // for size_t
+#include <iterator> // for move_iterator
+#include <list>     // for list
+#include <memory>   // for unique_ptr, make_unique
+#include <numeric>  // for iota
+#include <ranges>   // for subrange
+#include <string>   // for basic_string
+#include <thread>   // for thread, sleep_for
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, cart_capacity
+
+#include "../atomic_count.hpp"              // for atomic_count
+#include "../concurrent_cross_off_list.hpp" // for concurrent_cross_off_list
+
+static constexpr std::chrono::milliseconds wait_time(10);
+
+TEST(multiple_item_cart_enqueue_range, single_cart)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 3}};
+
+    std::vector<value_type> values{100, 101, 102};
+
+    EXPECT_EQ(queue.enqueue_range(scq::slot_id{1}, values), 3u);
+
+    scq::cart_future<value_type> cart = queue.dequeue();
+    EXPECT_TRUE(cart.valid());
+    std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+
+    EXPECT_EQ(cart_data.first.value, 1u);
+    EXPECT_EQ(cart_data.second.size(), 3u);
+    EXPECT_EQ(cart_data.second[0], value_type{100});
+    EXPECT_EQ(cart_data.second[1], value_type{101});
+    EXPECT_EQ(cart_data.second[2], value_type{102});
+}
+
+TEST(multiple_item_cart_enqueue_range, range_spans_multiple_carts)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    // expected set contains all (expected) results; after the test which set should be empty (each matching result will
+    // be crossed out)
+    concurrent_cross_off_list<std::pair<size_t, value_type>> expected{{1, value_type{99}},
+                                                                      {1, value_type{100}},
+                                                                      {1, value_type{101}},
+                                                                      {1, value_type{102}},
+                                                                      {1, value_type{103}},
+                                                                      {1, value_type{104}}};
+
+    // fills up the already started cart first
+    queue.enqueue(scq::slot_id{1}, value_type{99});
+
+    // a non-contiguous range
+    std::list<value_type> values{100, 101, 102, 103, 104};
+
+    EXPECT_EQ(queue.enqueue_range(scq::slot_id{1}, values), 5u); // completes the started cart and fills two more
+
+    queue.close();
+
+    size_t full_cart_count{};
+    size_t half_filled_cart_count{};
+
+    for (int i = 0; i < 3; ++i)
+    {
+        scq::cart_future<value_type> cart = queue.dequeue();
+        EXPECT_TRUE(cart.valid());
+        std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+
+        half_filled_cart_count += cart_data.second.size() == 1;
+        full_cart_count += cart_data.second.size() == 2;
+
+        for (auto && value : cart_data.second)
+        {
+            EXPECT_TRUE(expected.cross_off({cart_data.first.value, value}));
+        }
+    }
+
+    EXPECT_FALSE(queue.dequeue().valid());
+
+    EXPECT_EQ(full_cart_count, 3u);
+    EXPECT_EQ(half_filled_cart_count, 0u);
+
+    // all results seen
+    EXPECT_TRUE(expected.empty());
+}
+
+TEST(multiple_item_cart_enqueue_range, empty_range)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    EXPECT_EQ(queue.enqueue_range(scq::slot_id{1}, std::vector<value_type>{}), 0u);
+
+    queue.close();
+
+    EXPECT_FALSE(queue.dequeue().valid());
+}
+
+TEST(multiple_item_cart_enqueue_range, move_only_values)
+{
+    using value_type = std::unique_ptr<int>;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    std::vector<value_type> values{};
+    values.push_back(std::make_unique<int>(100));
+    values.push_back(std::make_unique<int>(101));
+
+    EXPECT_EQ(queue.enqueue_range(scq::slot_id{2},
+                                  std::ranges::subrange{std::move_iterator{values.begin()},
+                                                        std::move_iterator{values.end()}}),
+              2u);
+
+    // values were moved into the queue
+    EXPECT_EQ(values[0], nullptr);
+    EXPECT_EQ(values[1], nullptr);
+
+    scq::cart_future<value_type> cart = queue.dequeue();
+    EXPECT_TRUE(cart.valid());
+    std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+
+    EXPECT_EQ(cart_data.first.value, 2u);
+    EXPECT_EQ(cart_data.second.size(), 2u);
+    EXPECT_EQ(*cart_data.second[0], 100);
+    EXPECT_EQ(*cart_data.second[1], 101);
+}
+
+TEST(multiple_item_cart_enqueue_range, enqueue_range_after_close)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    queue.close();
+
+    // no exception, but no element was enqueued
+    EXPECT_EQ(queue.enqueue_range(scq::slot_id{1}, std::vector<value_type>{100, 101, 102}), 0u);
+}
+
+TEST(multiple_item_cart_enqueue_range, release_blocking_enqueue_range_when_close)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 2, .carts = 2, .capacity = 2}};
+
+    std::vector<value_type> values(10);
+    std::iota(values.begin(), values.end(), 100);
+
+    atomic_count enqueue_count{};
+    size_t enqueued{};
+
+    std::thread enqueue_thread{[&]
+                               {
+                                   // only 2 carts with capacity 2 are available, i.e. the 5th element blocks
+                                   enqueued = queue.enqueue_range(scq::slot_id{1}, values);
+                                   ++enqueue_count;
+                               }};
+
+    // the producer should block until the queue was closed
+    std::this_thread::sleep_for(wait_time);
+    EXPECT_EQ(enqueue_count.load(), 0u);
+
+    queue.close();
+
+    enqueue_thread.join();
+
+    EXPECT_EQ(enqueue_count.load(), 1u);
+    EXPECT_EQ(enqueued, 4u);
+
+    // both full carts can still be processed
+    for (int i = 0; i < 2; ++i)
+    {
+        scq::cart_future<value_type> cart = queue.dequeue();
+        EXPECT_TRUE(cart.valid());
+        EXPECT_EQ(cart.get().second.size(), 2u);
+    }
+
+    EXPECT_FALSE(queue.dequeue().valid());
+}
+
+TEST(multiple_item_cart_enqueue_range, multiple_producer_multiple_consumer)
+{
+    using value_type = int;
+
+    static constexpr size_t slot_count{5};
+    static constexpr size_t cart_capacity{8};
+    static constexpr size_t value_count{1000};
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = slot_count, .carts = 10, .capacity = cart_capacity}};
+
+    // expected set contains all (expected) results; after the test which set should be empty (each matching result will
+    // be crossed out)
+    concurrent_cross_off_list<std::pair<size_t, value_type>> expected{};
+    for (size_t thread_id = 0; thread_id < slot_count; ++thread_id)
+        for (size_t i = 0; i < value_count; ++i)
+            expected.insert(std::pair<size_t, value_type>{thread_id, i});
+
+    std::vector<std::thread> enqueue_threads{};
+    for (size_t thread_id = 0; thread_id < slot_count; ++thread_id)
+    {
+        enqueue_threads.emplace_back(
+            [thread_id, &queue]
+            {
+                // enqueue in chunks that do not line up with the cart capacity
+                std::vector<value_type> chunk{};
+                for (size_t i = 0; i < value_count; ++i)
+                {
+                    chunk.push_back(static_cast<value_type>(i));
+                    if (chunk.size() == 13u || i + 1 == value_count)
+                    {
+                        EXPECT_EQ(queue.enqueue_range(scq::slot_id{thread_id}, chunk), chunk.size());
+                        chunk.clear();
+                    }
+                }
+            });
+    }
+
+    std::vector<std::thread> dequeue_threads{};
+    for (size_t thread_id = 0; thread_id < 5; ++thread_id)
+    {
+        dequeue_threads.emplace_back(
+            [&queue, &expected]
+            {
+                while (true)
+                {
+                    scq::cart_future<value_type> cart = queue.dequeue(); // might block
+
+                    if (!cart.valid())
+                        break;
+
+                    std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+
+                    for (auto && value : cart_data.second)
+                    {
+                        EXPECT_TRUE(expected.cross_off({cart_data.first.value, value}));
+                    }
+                }
+            });
+    }
+
+    for (auto && enqueue_thread : enqueue_threads)
+        enqueue_thread.join();
+
+    queue.close();
+
+    for (auto && dequeue_thread : dequeue_threads)
+        dequeue_thread.join();
+
+    // all results seen
+    EXPECT_TRUE(expected.empty());
+}
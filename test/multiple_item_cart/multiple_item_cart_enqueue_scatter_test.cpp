@@ -0,0 +1,251 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <algorithm> // for ranges::sort
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+#include <random>    // for mt19937_64, uniform_int_distribution
+#include <stdexcept> // for logic_error
+#include <string>    // for basic_string, string
+#include <thread>    // for thread
+#include <utility>   // for pair
+#include <vector>    // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, cart_capacity
+
+#include "../concurrent_cross_off_list.hpp" // for concurrent_cross_off_list
+
+TEST(multiple_item_cart_enqueue_scatter, partition_by_slot)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 3, .carts = 3, .capacity = 3}};
+
+    std::vector<scq::slot_id> slots{{2}, {0}, {2}, {1}, {2}, {0}};
+    std::vector<value_type> values{200, 100, 201, 300, 202, 101};
+
+    EXPECT_EQ(queue.enqueue_scatter(slots, values), 6u);
+
+    // only the cart of slot 2 is full
+    {
+        scq::cart_future<value_type> cart = queue.dequeue();
+        EXPECT_TRUE(cart.valid());
+        std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+
+        EXPECT_EQ(cart_data.first.value, 2u);
+        EXPECT_EQ(cart_data.second.size(), 3u);
+
+        // keeps the relative order of the values of the slot
+        EXPECT_EQ(cart_data.second[0], value_type{200});
+        EXPECT_EQ(cart_data.second[1], value_type{201});
+        EXPECT_EQ(cart_data.second[2], value_type{202});
+    }
+
+    queue.close();
+
+    std::vector<std::vector<value_type>> slot_values(3);
+    for (scq::cart_future<value_type> cart = queue.dequeue(); cart.valid(); cart = queue.dequeue())
+    {
+        std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+        slot_values[cart_data.first.value].assign(cart_data.second.begin(), cart_data.second.end());
+    }
+
+    EXPECT_EQ(slot_values[0], (std::vector<value_type>{100, 101}));
+    EXPECT_EQ(slot_values[1], (std::vector<value_type>{300}));
+    EXPECT_TRUE(slot_values[2].empty());
+}
+
+TEST(multiple_item_cart_enqueue_scatter, spans_multiple_carts)
+{
+    using value_type = std::string;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 2, .carts = 4, .capacity = 2}};
+
+    std::vector<scq::slot_id> slots{{1}, {1}, {1}, {1}, {1}};
+    std::vector<value_type> values{"a", "b", "c", "d", "e"};
+
+    EXPECT_EQ(queue.enqueue_scatter(slots, values), 5u);
+
+    queue.close();
+
+    std::vector<value_type> dequeued_values{};
+    size_t cart_count{};
+    for (scq::cart_future<value_type> cart = queue.dequeue(); cart.valid(); cart = queue.dequeue())
+    {
+        ++cart_count;
+        for (value_type const & value : cart.get().second)
+            dequeued_values.push_back(value);
+    }
+
+    std::ranges::sort(dequeued_values);
+
+    EXPECT_EQ(cart_count, 3u);
+    EXPECT_EQ(dequeued_values, values);
+}
+
+TEST(multiple_item_cart_enqueue_scatter, simd_scatter)
+{
+    using value_type = uint64_t;
+
+    static constexpr size_t slot_count{64};
+    static constexpr size_t value_count{10000};
+
+    scq::slotted_cart_queue<value_type> queue{
+        {.slots = slot_count, .carts = slot_count, .capacity = 1000, .simd_scatter = true}};
+
+    std::mt19937_64 engine{};
+    std::uniform_int_distribution<size_t> distribution{0u, slot_count - 1u};
+
+    std::vector<scq::slot_id> slots{};
+    std::vector<value_type> values{};
+    std::vector<std::vector<value_type>> expected_slot_values(slot_count);
+    for (size_t i = 0; i < value_count; ++i)
+    {
+        slots.push_back(scq::slot_id{distribution(engine)});
+        values.push_back(engine());
+        expected_slot_values[slots.back().value].push_back(values.back());
+    }
+
+    EXPECT_EQ(queue.enqueue_scatter(slots, values), value_count);
+
+    queue.close();
+
+    std::vector<std::vector<value_type>> slot_values(slot_count);
+    for (scq::cart_future<value_type> cart = queue.dequeue(); cart.valid(); cart = queue.dequeue())
+    {
+        std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+        slot_values[cart_data.first.value].assign(cart_data.second.begin(), cart_data.second.end());
+    }
+
+    // keeps the relative order of the values of each slot
+    EXPECT_EQ(slot_values, expected_slot_values);
+}
+
+TEST(multiple_item_cart_enqueue_scatter, empty_batch)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    EXPECT_EQ(queue.enqueue_scatter({}, {}), 0u);
+
+    queue.close();
+
+    EXPECT_FALSE(queue.dequeue().valid());
+}
+
+TEST(multiple_item_cart_enqueue_scatter, size_mismatch)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    std::vector<scq::slot_id> slots{{1}, {2}};
+    std::vector<value_type> values{100};
+
+    EXPECT_THROW(queue.enqueue_scatter(slots, values), std::logic_error);
+}
+
+TEST(multiple_item_cart_enqueue_scatter, enqueue_scatter_after_close)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    queue.close();
+
+    std::vector<scq::slot_id> slots{{1}, {2}};
+    std::vector<value_type> values{100, 101};
+
+    // no exception, but no element was enqueued
+    EXPECT_EQ(queue.enqueue_scatter(slots, values), 0u);
+}
+
+TEST(multiple_item_cart_enqueue_scatter, multiple_producer_multiple_consumer)
+{
+    using value_type = int;
+
+    static constexpr size_t slot_count{16};
+    static constexpr size_t thread_count{4};
+    static constexpr size_t batch_count{50};
+    static constexpr size_t batch_size{100};
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = slot_count, .carts = 20, .capacity = 8}};
+
+    // each producer draws its (slot, value) pairs from its own engine
+    auto make_batches = [](size_t thread_id)
+    {
+        std::mt19937_64 engine{thread_id};
+        std::uniform_int_distribution<size_t> distribution{0u, slot_count - 1u};
+
+        std::vector<std::pair<std::vector<scq::slot_id>, std::vector<value_type>>> batches(batch_count);
+        for (size_t batch_id = 0; batch_id < batch_count; ++batch_id)
+        {
+            for (size_t i = 0; i < batch_size; ++i)
+            {
+                batches[batch_id].first.push_back(scq::slot_id{distribution(engine)});
+                batches[batch_id].second.push_back(
+                    static_cast<value_type>((thread_id * batch_count + batch_id) * batch_size + i));
+            }
+        }
+        return batches;
+    };
+
+    // expected set contains all (expected) results; after the test which set should be empty (each matching result will
+    // be crossed out)
+    concurrent_cross_off_list<std::pair<size_t, value_type>> expected{};
+    for (size_t thread_id = 0; thread_id < thread_count; ++thread_id)
+        for (auto && [slots, values] : make_batches(thread_id))
+            for (size_t i = 0; i < slots.size(); ++i)
+                expected.insert(std::pair<size_t, value_type>{slots[i].value, values[i]});
+
+    std::vector<std::thread> enqueue_threads{};
+    for (size_t thread_id = 0; thread_id < thread_count; ++thread_id)
+    {
+        enqueue_threads.emplace_back(
+            [thread_id, &queue, &make_batches]
+            {
+                for (auto && [slots, values] : make_batches(thread_id))
+                {
+                    EXPECT_EQ(queue.enqueue_scatter(slots, values), batch_size);
+                }
+            });
+    }
+
+    std::vector<std::thread> dequeue_threads{};
+    for (size_t thread_id = 0; thread_id < thread_count; ++thread_id)
+    {
+        dequeue_threads.emplace_back(
+            [&queue, &expected]
+            {
+                while (true)
+                {
+                    scq::cart_future<value_type> cart = queue.dequeue(); // might block
+
+                    if (!cart.valid())
+                        break;
+
+                    std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+
+                    for (auto && value : cart_data.second)
+                    {
+                        EXPECT_TRUE(expected.cross_off({cart_data.first.value, value}));
+                    }
+                }
+            });
+    }
+
+    for (auto && enqueue_thread : enqueue_threads)
+        enqueue_thread.join();
+
+    queue.close();
+
+    for (auto && dequeue_thread : dequeue_threads)
+        dequeue_thread.join();
+
+    // all results seen
+    EXPECT_TRUE(expected.empty());
+}
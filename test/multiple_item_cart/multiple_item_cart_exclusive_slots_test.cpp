@@ -0,0 +1,192 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <atomic>  // for atomic
+#include <chrono>  // for milliseconds
+#include <cstddef> // for size_t
+#include <memory>  // for shared_ptr, make_shared
+#include <thread>  // for thread
+#include <utility> // for move
+#include <vector>  // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, queue_op_status
+
+TEST(multiple_item_cart_exclusive_slots, hold_back_carts_of_processed_slot)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{
+        {.slots = 3, .carts = 6, .capacity = 1, .cart_order = scq::cart_order::fifo, .exclusive_slots = true}};
+
+    for (value_type value : {0, 1, 100, 2})
+        queue.enqueue(scq::slot_id{static_cast<size_t>(value / 100)}, value);
+
+    scq::cart_future<value_type> first_cart = queue.dequeue();
+    EXPECT_EQ(first_cart.get().first.value, 0u);
+
+    // the other carts of slot 0 are held back while the first one is processed
+    scq::cart_future<value_type> second_cart = queue.dequeue();
+    EXPECT_EQ(second_cart.get().first.value, 1u);
+
+    scq::cart_future<value_type> cart{};
+    EXPECT_EQ(queue.try_dequeue(cart), scq::queue_op_status::would_block);
+
+    // processing the cart of slot 0 releases its next cart
+    first_cart = scq::cart_future<value_type>{};
+    EXPECT_EQ(queue.try_dequeue(cart), scq::queue_op_status::ok);
+    EXPECT_EQ(cart.get().first.value, 0u);
+    EXPECT_EQ(cart.get().second[0], 1);
+
+    // the slot is still blocked by cart
+    scq::cart_future<value_type> other_cart{};
+    EXPECT_EQ(queue.try_dequeue(other_cart), scq::queue_op_status::would_block);
+
+    cart = scq::cart_future<value_type>{};
+    EXPECT_EQ(queue.try_dequeue(cart), scq::queue_op_status::ok);
+    EXPECT_EQ(cart.get().second[0], 2);
+}
+
+TEST(multiple_item_cart_exclusive_slots, close_waits_for_held_back_carts)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 3, .carts = 6, .capacity = 1, .exclusive_slots = true}};
+
+    queue.enqueue(scq::slot_id{0}, 0);
+    queue.enqueue(scq::slot_id{0}, 1);
+    queue.close();
+
+    scq::cart_future<value_type> first_cart = queue.dequeue();
+    EXPECT_TRUE(first_cart.valid());
+
+    // the consumer waits for the held back cart instead of reporting the queue as closed
+    std::thread consumer{[&queue]()
+                         {
+                             scq::cart_future<value_type> cart = queue.dequeue();
+                             EXPECT_TRUE(cart.valid());
+                             EXPECT_EQ(cart.get().second[0], 1);
+
+                             cart = queue.dequeue();
+                             EXPECT_FALSE(cart.valid());
+                         }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    first_cart = scq::cart_future<value_type>{};
+
+    consumer.join();
+}
+
+TEST(multiple_item_cart_exclusive_slots, dequeue_batch_releases_slots)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 3, .carts = 6, .capacity = 1, .exclusive_slots = true}};
+
+    for (value_type value : {0, 1, 100, 101})
+        queue.enqueue(scq::slot_id{static_cast<size_t>(value / 100)}, value);
+
+    {
+        // at most one cart per slot
+        scq::cart_batch<value_type> batch = queue.dequeue_batch(4u);
+        EXPECT_EQ(batch.get().size(), 2u);
+        EXPECT_NE(batch.get()[0].first.value, batch.get()[1].first.value);
+    }
+
+    scq::cart_batch<value_type> batch = queue.dequeue_batch(4u);
+    EXPECT_EQ(batch.get().size(), 2u);
+}
+
+TEST(multiple_item_cart_exclusive_slots, destroy_held_back_elements)
+{
+    using value_type = std::shared_ptr<int>;
+
+    value_type value = std::make_shared<int>(1);
+
+    {
+        scq::slotted_cart_queue<value_type> queue{
+            {.slots = 3, .carts = 6, .capacity = 1, .exclusive_slots = true}};
+
+        for (size_t i = 0; i < 3u; ++i)
+            queue.enqueue(scq::slot_id{0}, value);
+
+        EXPECT_EQ(value.use_count(), 4);
+    }
+
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(multiple_item_cart_exclusive_slots, concurrent_unsynchronised_slot_state)
+{
+    using value_type = size_t;
+
+    size_t const slot_count = 4u;
+    size_t const producer_count = 4u;
+    size_t const consumer_count = 4u;
+    size_t const values_per_producer = 4000u;
+
+    scq::slotted_cart_queue<value_type> queue{
+        {.slots = slot_count, .carts = 12, .capacity = 3, .exclusive_slots = true}};
+
+    std::vector<std::thread> producers{};
+    for (size_t producer = 0u; producer < producer_count; ++producer)
+    {
+        producers.emplace_back(
+            [&queue, producer]()
+            {
+                for (size_t i = 0u; i < values_per_producer; ++i)
+                {
+                    size_t const value = producer * values_per_producer + i;
+                    queue.enqueue(scq::slot_id{value % slot_count}, value);
+                }
+            });
+    }
+
+    // the per-slot state is not synchronised, the queue guarantees exclusive access
+    std::vector<size_t> slot_sums(slot_count);
+    std::vector<std::atomic<size_t>> slot_users(slot_count);
+
+    std::vector<std::thread> consumers{};
+    for (size_t consumer = 0u; consumer < consumer_count; ++consumer)
+    {
+        consumers.emplace_back(
+            [&]()
+            {
+                while (true)
+                {
+                    scq::cart_future<value_type> cart = queue.dequeue();
+
+                    if (!cart.valid())
+                        break;
+
+                    auto [slot, memory_region] = cart.get();
+                    EXPECT_EQ(slot_users[slot.value].fetch_add(1u), 0u);
+
+                    for (value_type value : memory_region)
+                        slot_sums[slot.value] += value;
+
+                    EXPECT_EQ(slot_users[slot.value].fetch_sub(1u), 1u);
+                }
+            });
+    }
+
+    for (std::thread & producer : producers)
+        producer.join();
+
+    queue.close();
+
+    for (std::thread & consumer : consumers)
+        consumer.join();
+
+    size_t const value_count = producer_count * values_per_producer;
+    for (size_t slot = 0u; slot < slot_count; ++slot)
+    {
+        size_t expected_sum{};
+        for (size_t value = slot; value < value_count; value += slot_count)
+            expected_sum += value;
+
+        EXPECT_EQ(slot_sums[slot], expected_sum);
+    }
+}
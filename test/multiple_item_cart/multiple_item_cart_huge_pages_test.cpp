@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <cstddef> // for size_t
+#include <string>  // for string, to_string
+#include <utility> // for pair
+#include <vector>  // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, cart_memory_pages
+
+#include "../slotted_cart_queue_types.hpp" // for slotted_cart_queue_types, slotted_cart_queue_type_names, cart_futu...
+
+template <typename queue_t>
+class multiple_item_cart_huge_pages : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(multiple_item_cart_huge_pages, slotted_cart_queue_types<int>, slotted_cart_queue_type_names);
+
+TYPED_TEST(multiple_item_cart_huge_pages, allocator_by_default)
+{
+    TypeParam queue{{.slots = 2, .carts = 4, .capacity = 8}};
+
+    EXPECT_EQ(queue.cart_memory_pages(), scq::cart_memory_pages::allocator);
+}
+
+TYPED_TEST(multiple_item_cart_huge_pages, reports_pages)
+{
+    TypeParam queue{{.slots = 2, .carts = 4, .capacity = 8, .huge_pages = true}};
+
+#if defined(__linux__)
+    // which kind of pages is available depends on the system
+    EXPECT_NE(queue.cart_memory_pages(), scq::cart_memory_pages::allocator);
+#else
+    EXPECT_EQ(queue.cart_memory_pages(), scq::cart_memory_pages::allocator);
+#endif
+}
+
+TYPED_TEST(multiple_item_cart_huge_pages, enqueue_dequeue)
+{
+    using value_type = int;
+
+    size_t const slot_count = 4u;
+    size_t const cart_count = 8u;
+    size_t const cart_capacity = 1000u;
+
+    TypeParam queue{{.slots = slot_count, .carts = cart_count, .capacity = cart_capacity, .huge_pages = true}};
+
+    // each slot gets cart_capacity many values i * slot_count + slot
+    std::vector<size_t> value_sums(slot_count);
+
+    for (size_t round = 0u; round < 3u; ++round)
+    {
+        for (size_t i = 0u; i < slot_count * cart_capacity; ++i)
+            queue.enqueue(scq::slot_id{i % slot_count}, static_cast<value_type>(i));
+
+        for (size_t cart = 0u; cart < slot_count; ++cart)
+        {
+            cart_future_t<TypeParam> cart_future = queue.dequeue();
+            ASSERT_TRUE(cart_future.valid());
+
+            std::pair<scq::slot_id, std::span<value_type>> cart_data = cart_future.get();
+            EXPECT_EQ(cart_data.second.size(), cart_capacity);
+
+            for (value_type value : cart_data.second)
+            {
+                EXPECT_EQ(static_cast<size_t>(value) % slot_count, cart_data.first.value);
+                value_sums[cart_data.first.value] += value;
+            }
+        }
+    }
+
+    queue.close();
+    EXPECT_FALSE(queue.dequeue().valid());
+
+    // the values i * slot_count + slot for i in [0, cart_capacity), three rounds
+    for (size_t slot = 0u; slot < slot_count; ++slot)
+    {
+        size_t const slot_value_sum = cart_capacity * (cart_capacity - 1u) / 2u * slot_count + cart_capacity * slot;
+        EXPECT_EQ(value_sums[slot], 3u * slot_value_sum);
+    }
+}
+
+// The elements of carts that were not processed are destroyed within the mapping.
+TEST(multiple_item_cart_huge_pages, non_trivial_values)
+{
+    scq::slotted_cart_queue<std::string> queue{{.slots = 2, .carts = 4, .capacity = 3, .huge_pages = true}};
+
+    for (size_t i = 0u; i < 8u; ++i)
+        queue.enqueue(scq::slot_id{i % 2u}, std::string(64u, static_cast<char>('a' + i)));
+
+    scq::cart_future<std::string> cart = queue.dequeue();
+    ASSERT_TRUE(cart.valid());
+
+    for (std::string const & value : cart.get().second)
+        EXPECT_EQ(value.size(), 64u);
+}
@@ -0,0 +1,256 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <algorithm> // for sort
+#include <atomic>    // for atomic
+#include <chrono>    // for milliseconds
+#include <cstddef>   // for size_t
+#include <memory>    // for shared_ptr, make_shared
+#include <mutex>     // for mutex, scoped_lock
+#include <numeric>   // for iota
+#include <stdexcept> // for logic_error
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, queue_op_status, wait_...
+
+TEST(multiple_item_cart_lock_free_full_carts, fifo)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{
+        {.slots = 3, .carts = 8, .capacity = 2, .cart_order = scq::cart_order::fifo, .lock_free_full_carts = true}};
+
+    // slot 0 fills three carts, slot 1 one cart and slot 2 two carts
+    for (value_type value : {0, 1, 2, 3, 100, 101, 4, 5, 200, 201, 202, 203})
+        queue.enqueue(scq::slot_id{static_cast<size_t>(value / 100)}, value);
+
+    queue.close();
+
+    std::vector<int> first_values{};
+    for (scq::cart_future<value_type> cart = queue.dequeue(); cart.valid(); cart = queue.dequeue())
+        first_values.push_back(cart.get().second[0]);
+
+    EXPECT_EQ(first_values, (std::vector<int>{0, 2, 100, 4, 200, 202}));
+}
+
+TEST(multiple_item_cart_lock_free_full_carts, try_and_timed_dequeue)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{
+        {.slots = 2, .carts = 3, .capacity = 1, .cart_order = scq::cart_order::fifo, .lock_free_full_carts = true}};
+
+    scq::cart_future<value_type> cart{};
+    EXPECT_EQ(queue.try_dequeue(cart), scq::queue_op_status::would_block);
+    EXPECT_EQ(queue.dequeue_for(cart, std::chrono::milliseconds{10}), scq::queue_op_status::timeout);
+
+    queue.enqueue(scq::slot_id{1}, 1);
+    EXPECT_EQ(queue.try_dequeue(cart), scq::queue_op_status::ok);
+    EXPECT_EQ(cart.get().second[0], 1);
+
+    queue.close();
+    EXPECT_EQ(queue.try_dequeue(cart), scq::queue_op_status::closed);
+}
+
+TEST(multiple_item_cart_lock_free_full_carts, dequeue_batch)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{
+        {.slots = 4, .carts = 4, .capacity = 1, .cart_order = scq::cart_order::fifo, .lock_free_full_carts = true}};
+
+    for (value_type value : {0, 1, 2})
+        queue.enqueue(scq::slot_id{static_cast<size_t>(value)}, value);
+
+    {
+        scq::cart_batch<value_type> batch = queue.dequeue_batch(2u);
+        ASSERT_EQ(batch.get().size(), 2u);
+        EXPECT_EQ(batch.get()[0].second[0], 0);
+        EXPECT_EQ(batch.get()[1].second[0], 1);
+    }
+
+    // the batch is limited to max_count, the remaining cart stays in the queue
+    EXPECT_EQ(queue.dequeue().get().second[0], 2);
+
+    EXPECT_THROW((void)queue.dequeue_coalesced(), std::logic_error);
+}
+
+TEST(multiple_item_cart_lock_free_full_carts, invalid_params)
+{
+    using value_type = int;
+
+    // the ring hands out the carts in the order they were published, i.e. fifo over all slots
+    EXPECT_THROW((scq::slotted_cart_queue<value_type>{{.slots = 2,
+                                                       .carts = 2,
+                                                       .capacity = 1,
+                                                       .cart_order = scq::cart_order::lifo,
+                                                       .lock_free_full_carts = true}}),
+                 std::logic_error);
+    EXPECT_THROW((scq::slotted_cart_queue<value_type>{{.slots = 2,
+                                                       .carts = 2,
+                                                       .capacity = 1,
+                                                       .cart_order = scq::cart_order::fifo,
+                                                       .partitions = 2,
+                                                       .lock_free_full_carts = true}}),
+                 std::logic_error);
+    EXPECT_THROW((scq::slotted_cart_queue<value_type>{{.slots = 2,
+                                                       .carts = 2,
+                                                       .capacity = 1,
+                                                       .cart_order = scq::cart_order::fifo,
+                                                       .exclusive_slots = true,
+                                                       .lock_free_full_carts = true}}),
+                 std::logic_error);
+}
+
+TEST(multiple_item_cart_lock_free_full_carts, destroy_unprocessed_elements)
+{
+    using value_type = std::shared_ptr<int>;
+
+    value_type value = std::make_shared<int>(1);
+
+    {
+        scq::slotted_cart_queue<value_type> queue{
+            {.slots = 3, .carts = 5, .capacity = 1, .cart_order = scq::cart_order::fifo, .lock_free_full_carts = true}};
+
+        for (size_t slot : {0u, 1u, 0u, 2u, 0u})
+            queue.enqueue(scq::slot_id{slot}, value);
+
+        EXPECT_EQ(queue.dequeue().get().second.size(), 1u);
+        EXPECT_EQ(value.use_count(), 5);
+    }
+
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+static void concurrent_enqueue_dequeue(scq::wait_strategy wait_strategy)
+{
+    using value_type = size_t;
+
+    size_t const slot_count = 5u;
+    size_t const producer_count = 4u;
+    size_t const consumer_count = 3u;
+    size_t const values_per_producer = 5000u;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = slot_count,
+                                               .carts = 10,
+                                               .capacity = 3,
+                                               .cart_order = scq::cart_order::fifo,
+                                               .wait_strategy = wait_strategy,
+                                               .lock_free_full_carts = true}};
+
+    std::mutex dequeued_values_mutex{};
+    std::vector<value_type> dequeued_values{};
+
+    std::vector<std::thread> consumers{};
+    for (size_t consumer_id = 0u; consumer_id < consumer_count; ++consumer_id)
+    {
+        consumers.emplace_back(
+            [&]()
+            {
+                std::vector<value_type> values{};
+
+                for (scq::cart_future<value_type> cart = queue.dequeue(); cart.valid(); cart = queue.dequeue())
+                {
+                    auto [slot, memory_region] = cart.get();
+
+                    for (value_type value : memory_region)
+                    {
+                        EXPECT_EQ(value % slot_count, slot.value);
+                        values.push_back(value);
+                    }
+                }
+
+                std::scoped_lock lock{dequeued_values_mutex};
+                dequeued_values.insert(dequeued_values.end(), values.begin(), values.end());
+            });
+    }
+
+    std::vector<std::thread> producers{};
+    for (size_t producer_id = 0u; producer_id < producer_count; ++producer_id)
+    {
+        producers.emplace_back(
+            [&queue, producer_id]()
+            {
+                for (size_t i = 0u; i < values_per_producer; ++i)
+                {
+                    size_t const value = producer_id * values_per_producer + i;
+                    queue.enqueue(scq::slot_id{value % slot_count}, value);
+                }
+            });
+    }
+
+    for (std::thread & producer : producers)
+        producer.join();
+
+    queue.close();
+
+    for (std::thread & consumer : consumers)
+        consumer.join();
+
+    std::vector<value_type> expected_values(producer_count * values_per_producer);
+    std::iota(expected_values.begin(), expected_values.end(), 0u);
+
+    std::ranges::sort(dequeued_values);
+    EXPECT_EQ(dequeued_values, expected_values);
+}
+
+TEST(multiple_item_cart_lock_free_full_carts, concurrent)
+{
+    concurrent_enqueue_dequeue(scq::wait_strategy::block);
+}
+
+TEST(multiple_item_cart_lock_free_full_carts, concurrent_spin_then_block)
+{
+    concurrent_enqueue_dequeue(scq::wait_strategy::spin_then_block);
+}
+
+TEST(multiple_item_cart_lock_free_full_carts, consumers)
+{
+    using value_type = size_t;
+
+    size_t const slot_count = 5u;
+    size_t const values_per_producer = 5000u;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = slot_count,
+                                               .carts = 10,
+                                               .capacity = 4,
+                                               .cart_order = scq::cart_order::fifo,
+                                               .lock_free_full_carts = true}};
+
+    std::atomic<size_t> value_sum{};
+
+    // the consumer threads suspend as async waiters and are handed the carts directly
+    queue.start_consumers(scq::consumers{3},
+                          [&value_sum](scq::slot_id, std::span<value_type> memory_region)
+                          {
+                              for (value_type value : memory_region)
+                                  value_sum += value;
+                          });
+
+    std::vector<std::thread> producers{};
+    for (size_t producer_id = 0u; producer_id < 2u; ++producer_id)
+    {
+        producers.emplace_back(
+            [&queue, producer_id]()
+            {
+                for (size_t i = 0u; i < values_per_producer; ++i)
+                {
+                    size_t const value = producer_id * values_per_producer + i;
+                    queue.enqueue(scq::slot_id{value % slot_count}, value);
+                }
+            });
+    }
+
+    for (std::thread & producer : producers)
+        producer.join();
+
+    queue.close();
+    queue.join_consumers();
+
+    size_t const value_count = 2u * values_per_producer;
+    EXPECT_EQ(value_sum, value_count * (value_count - 1u) / 2u);
+}
@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <atomic>          // for atomic
+#include <cstddef>         // for size_t, byte
+#include <memory_resource> // for memory_resource, monotonic_buffer_resource, null_memory_resource, set_default_resource
+#include <thread>          // for thread
+#include <vector>          // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, params
+
+#include "../slotted_cart_queue_types.hpp" // for slotted_cart_queue_types, slotted_cart_queue_type_names, cart_futu...
+
+// Forwards to new_delete_resource and counts the bytes that are currently allocated.
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+    size_t allocated_bytes{};
+    size_t allocation_count{};
+
+private:
+    void * do_allocate(size_t bytes, size_t alignment) override
+    {
+        allocated_bytes += bytes;
+        ++allocation_count;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void * pointer, size_t bytes, size_t alignment) override
+    {
+        allocated_bytes -= bytes;
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+template <typename queue_t>
+class multiple_item_cart_memory_resource : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(multiple_item_cart_memory_resource, slotted_cart_queue_types<int>, slotted_cart_queue_type_names);
+
+TYPED_TEST(multiple_item_cart_memory_resource, storage_is_allocated_from_memory_resource)
+{
+    using value_type = int;
+
+    counting_resource resource{};
+
+    {
+        TypeParam queue{{.slots = 5, .carts = 8, .capacity = 4, .memory_resource = &resource}};
+
+        // at least the cart memory
+        EXPECT_GE(resource.allocated_bytes, 8u * 4u * sizeof(value_type));
+
+        size_t const allocation_count = resource.allocation_count;
+
+        for (value_type value = 0; value < 40; ++value)
+        {
+            queue.enqueue(scq::slot_id{1}, value);
+
+            if (value % 4 == 3) // the cart of the slot is full
+            {
+                cart_future_t<TypeParam> cart = queue.dequeue();
+                EXPECT_TRUE(cart.valid());
+            }
+        }
+
+        queue.close();
+
+        // enqueue and dequeue do not allocate
+        EXPECT_EQ(resource.allocation_count, allocation_count);
+    }
+
+    EXPECT_EQ(resource.allocated_bytes, 0u);
+}
+
+TYPED_TEST(multiple_item_cart_memory_resource, monotonic_buffer_resource)
+{
+    using value_type = int;
+
+    size_t const slot_count = 4u;
+    size_t const producer_count = 3u;
+    size_t const values_per_producer = 1000u;
+
+    std::vector<std::byte> buffer(1u << 20);
+    // all storage has to come from the buffer: neither the upstream nor the default resource can allocate
+    std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+    std::pmr::memory_resource * default_resource = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+    TypeParam queue{{.slots = slot_count, .carts = 8, .capacity = 16, .memory_resource = &resource}};
+
+    std::pmr::set_default_resource(default_resource);
+
+    std::atomic<size_t> value_sum{};
+
+    std::thread consumer{[&]()
+                         {
+                             while (true)
+                             {
+                                 cart_future_t<TypeParam> cart = queue.dequeue();
+
+                                 if (!cart.valid())
+                                     break;
+
+                                 for (value_type value : cart.get().second)
+                                     value_sum += value;
+                             }
+                         }};
+
+    std::vector<std::thread> producers{};
+    for (size_t producer_id = 0u; producer_id < producer_count; ++producer_id)
+    {
+        producers.emplace_back(
+            [&queue, producer_id]()
+            {
+                for (size_t value = 0u; value < values_per_producer; ++value)
+                    queue.enqueue(scq::slot_id{(producer_id + value) % slot_count}, static_cast<value_type>(value));
+            });
+    }
+
+    for (std::thread & producer : producers)
+        producer.join();
+
+    queue.close();
+    consumer.join();
+
+    EXPECT_EQ(value_sum, producer_count * values_per_producer * (values_per_producer - 1u) / 2u);
+}
@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <algorithm> // for sort
+#include <chrono>    // for milliseconds
+#include <cstddef>   // for size_t
+#include <stdexcept> // for logic_error
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, partition_id, span, slotted_cart_queue, cart_future
+
+TEST(multiple_item_cart_partition, partition_of)
+{
+    scq::slotted_cart_queue<int> queue{{.slots = 5, .carts = 5, .capacity = 1, .partitions = 2}};
+
+    std::vector<size_t> partitions{};
+    for (size_t slot = 0; slot < 5u; ++slot)
+        partitions.push_back(queue.partition_of(scq::slot_id{slot}).value);
+
+    EXPECT_EQ(partitions, (std::vector<size_t>{0, 0, 0, 1, 1}));
+
+    EXPECT_THROW((scq::slotted_cart_queue<int>{{.slots = 5, .carts = 5, .capacity = 1, .partitions = 0}}),
+                 std::logic_error);
+    EXPECT_THROW((scq::slotted_cart_queue<int>{{.slots = 5, .carts = 5, .capacity = 1, .partitions = 6}}),
+                 std::logic_error);
+}
+
+TEST(multiple_item_cart_partition, dequeue_partition)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 4, .carts = 8, .capacity = 1, .partitions = 2}};
+
+    for (value_type value : {0, 100, 200, 300, 201, 1})
+        queue.enqueue(scq::slot_id{static_cast<size_t>(value / 100)}, value);
+
+    queue.close();
+
+    // partition 1 holds the slots 2 and 3
+    std::vector<value_type> partition_values{};
+    for (scq::cart_future<value_type> cart = queue.dequeue(scq::partition_id{1}); cart.valid();
+         cart = queue.dequeue(scq::partition_id{1}))
+    {
+        auto [slot, memory_region] = cart.get();
+        EXPECT_EQ(queue.partition_of(slot).value, 1u);
+        partition_values.push_back(memory_region[0]);
+    }
+
+    std::ranges::sort(partition_values);
+    EXPECT_EQ(partition_values, (std::vector<value_type>{200, 201, 300}));
+
+    // the remaining carts are handed out to consumers of any partition
+    std::vector<value_type> remaining_values{};
+    for (scq::cart_future<value_type> cart = queue.dequeue(); cart.valid(); cart = queue.dequeue())
+        remaining_values.push_back(cart.get().second[0]);
+
+    std::ranges::sort(remaining_values);
+    EXPECT_EQ(remaining_values, (std::vector<value_type>{0, 1, 100}));
+}
+
+TEST(multiple_item_cart_partition, dequeue_batch_partition)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{
+        {.slots = 4, .carts = 8, .capacity = 1, .cart_order = scq::cart_order::fifo, .partitions = 4}};
+
+    for (value_type value : {300, 0, 301, 100, 302})
+        queue.enqueue(scq::slot_id{static_cast<size_t>(value / 100)}, value);
+
+    scq::cart_batch<value_type> batch = queue.dequeue_batch(5u, scq::partition_id{3});
+    ASSERT_EQ(batch.get().size(), 3u);
+    EXPECT_EQ(batch.get()[0].second[0], 300);
+    EXPECT_EQ(batch.get()[1].second[0], 301);
+    EXPECT_EQ(batch.get()[2].second[0], 302);
+
+    // consumers of any partition take the partitions in turn
+    EXPECT_EQ(queue.dequeue().get().second[0], 0);
+    EXPECT_EQ(queue.dequeue().get().second[0], 100);
+}
+
+TEST(multiple_item_cart_partition, consumer_per_partition)
+{
+    using value_type = size_t;
+
+    size_t const slot_count = 12u;
+    size_t const partition_count = 3u;
+    size_t const producer_count = 4u;
+    size_t const values_per_producer = 3000u;
+
+    for (scq::cart_order cart_order : {scq::cart_order::lifo, scq::cart_order::fifo, scq::cart_order::round_robin})
+    {
+        scq::slotted_cart_queue<value_type> queue{{.slots = slot_count,
+                                                   .carts = slot_count + 4u,
+                                                   .capacity = 5,
+                                                   .cart_order = cart_order,
+                                                   .partitions = partition_count}};
+
+        std::vector<std::thread> producers{};
+        for (size_t producer = 0u; producer < producer_count; ++producer)
+        {
+            producers.emplace_back(
+                [&queue, producer]()
+                {
+                    for (size_t i = 0u; i < values_per_producer; ++i)
+                    {
+                        size_t const value = producer * values_per_producer + i;
+                        queue.enqueue(scq::slot_id{value % slot_count}, value);
+                    }
+                });
+        }
+
+        // each consumer owns the per-slot state of its partition, i.e. it is accessed without locking
+        std::vector<size_t> slot_sums(slot_count);
+        std::vector<size_t> slot_counts(slot_count);
+
+        std::vector<std::thread> consumers{};
+        for (size_t partition = 0u; partition < partition_count; ++partition)
+        {
+            consumers.emplace_back(
+                [&, partition]()
+                {
+                    for (scq::cart_future<value_type> cart = queue.dequeue(scq::partition_id{partition});
+                         cart.valid();
+                         cart = queue.dequeue(scq::partition_id{partition}))
+                    {
+                        auto [slot, memory_region] = cart.get();
+                        EXPECT_EQ(queue.partition_of(slot).value, partition);
+
+                        for (value_type value : memory_region)
+                        {
+                            slot_sums[slot.value] += value;
+                            ++slot_counts[slot.value];
+                        }
+                    }
+                });
+        }
+
+        for (std::thread & producer : producers)
+            producer.join();
+
+        queue.close();
+
+        for (std::thread & consumer : consumers)
+            consumer.join();
+
+        size_t const value_count = producer_count * values_per_producer;
+        for (size_t slot = 0u; slot < slot_count; ++slot)
+        {
+            size_t expected_sum{};
+            for (size_t value = slot; value < value_count; value += slot_count)
+                expected_sum += value;
+
+            EXPECT_EQ(slot_counts[slot], value_count / slot_count);
+            EXPECT_EQ(slot_sums[slot], expected_sum);
+        }
+    }
+}
+
+TEST(multiple_item_cart_partition, wake_up_consumer_of_any_partition)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 4, .carts = 4, .capacity = 1, .partitions = 2}};
+
+    // a cart of partition 1 must not be lost on the blocked consumer of partition 0
+    std::thread partition_consumer{[&queue]()
+                                   {
+                                       scq::cart_future<value_type> cart = queue.dequeue(scq::partition_id{0});
+                                       EXPECT_TRUE(cart.valid());
+                                       EXPECT_EQ(cart.get().second[0], 0);
+                                   }};
+
+    std::thread any_consumer{[&queue]()
+                             {
+                                 scq::cart_future<value_type> cart = queue.dequeue();
+                                 EXPECT_TRUE(cart.valid());
+                                 EXPECT_EQ(cart.get().second[0], 3);
+                             }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    queue.enqueue(scq::slot_id{3}, 3);
+    any_consumer.join();
+
+    queue.enqueue(scq::slot_id{0}, 0);
+    partition_consumer.join();
+}
@@ -0,0 +1,254 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <algorithm> // for sort
+#include <atomic>    // for atomic_bool
+#include <chrono>    // for milliseconds
+#include <cstddef>   // for size_t
+#include <future>    // for future_error
+#include <numeric>   // for iota
+#include <stdexcept> // for logic_error
+#include <thread>    // for thread, this_thread::sleep_for
+#include <utility>   // for pair, move
+#include <vector>    // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, cart_reservation
+
+TEST(multiple_item_cart_reserve, fill_in_place)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 4}};
+
+    scq::cart_reservation<value_type> reservation = queue.reserve(scq::slot_id{1}, 4u);
+    EXPECT_TRUE(reservation.valid());
+
+    std::span<value_type> memory_region = reservation.get();
+    EXPECT_EQ(memory_region.size(), 4u);
+    std::iota(memory_region.begin(), memory_region.end(), 100);
+
+    reservation.commit(4u);
+    EXPECT_FALSE(reservation.valid());
+    EXPECT_THROW(reservation.get(), std::future_error);
+
+    scq::cart_future<value_type> cart = queue.dequeue();
+    EXPECT_TRUE(cart.valid());
+    std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+
+    EXPECT_EQ(cart_data.first.value, 1u);
+    EXPECT_EQ((std::vector<value_type>(cart_data.second.begin(), cart_data.second.end())),
+              (std::vector<value_type>{100, 101, 102, 103}));
+}
+
+TEST(multiple_item_cart_reserve, reservation_is_limited_by_cart)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 4}};
+
+    queue.enqueue(scq::slot_id{1}, 100);
+
+    // only the remaining positions of the current cart are reserved
+    scq::cart_reservation<value_type> reservation = queue.reserve(scq::slot_id{1}, 10u);
+    EXPECT_EQ(reservation.get().size(), 3u);
+
+    std::ranges::fill(reservation.get(), 101);
+    reservation.commit(3u);
+
+    scq::cart_future<value_type> cart = queue.dequeue();
+    std::span<value_type> memory_region = cart.get().second;
+    EXPECT_EQ((std::vector<value_type>(memory_region.begin(), memory_region.end())),
+              (std::vector<value_type>{100, 101, 101, 101}));
+}
+
+TEST(multiple_item_cart_reserve, partial_commit)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 4}};
+
+    {
+        scq::cart_reservation<value_type> reservation = queue.reserve(scq::slot_id{1}, 4u);
+        reservation.get()[0] = 100;
+        reservation.get()[1] = 101;
+        EXPECT_THROW(reservation.commit(5u), std::logic_error);
+        reservation.commit(2u);
+    }
+
+    // the uncommitted positions are reserved by the next producer
+    queue.enqueue(scq::slot_id{1}, 102);
+
+    {
+        // a reservation that is not committed commits no elements
+        scq::cart_reservation<value_type> reservation = queue.reserve(scq::slot_id{1}, 4u);
+        EXPECT_EQ(reservation.get().size(), 1u);
+    }
+
+    queue.enqueue(scq::slot_id{1}, 103);
+
+    scq::cart_future<value_type> cart = queue.dequeue();
+    std::span<value_type> memory_region = cart.get().second;
+    EXPECT_EQ((std::vector<value_type>(memory_region.begin(), memory_region.end())),
+              (std::vector<value_type>{100, 101, 102, 103}));
+}
+
+TEST(multiple_item_cart_reserve, reserve_after_close)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 4}};
+
+    EXPECT_THROW((void)queue.reserve(scq::slot_id{1}, 0u), std::logic_error);
+
+    queue.close();
+
+    scq::cart_reservation<value_type> reservation = queue.reserve(scq::slot_id{1}, 4u);
+    EXPECT_FALSE(reservation.valid());
+    EXPECT_THROW(reservation.get(), std::future_error);
+}
+
+TEST(multiple_item_cart_reserve, close_publishes_committed_elements)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 4}};
+
+    scq::cart_reservation<value_type> reservation = queue.reserve(scq::slot_id{1}, 3u);
+    reservation.get()[0] = 100;
+    reservation.get()[1] = 101;
+
+    // close waits until the pending reservation was committed
+    std::thread closing_thread{[&queue]()
+                               {
+                                   queue.close();
+                               }};
+
+    reservation.commit(2u);
+    closing_thread.join();
+
+    scq::cart_future<value_type> cart = queue.dequeue();
+    EXPECT_TRUE(cart.valid());
+    std::span<value_type> memory_region = cart.get().second;
+    EXPECT_EQ((std::vector<value_type>(memory_region.begin(), memory_region.end())),
+              (std::vector<value_type>{100, 101}));
+
+    cart = queue.dequeue();
+    EXPECT_FALSE(cart.valid());
+}
+
+// close blocks while another thread holds a reservation and returns once it was committed or destroyed.
+TEST(multiple_item_cart_reserve, close_waits_for_pending_reservation)
+{
+    using value_type = int;
+
+    for (bool commit : {true, false})
+    {
+        scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 4}};
+        queue.enqueue(scq::slot_id{2}, 7);
+
+        std::atomic_bool reserved{false};
+        std::atomic_bool release_reservation{false};
+
+        std::thread producer{[&]()
+                             {
+                                 scq::cart_reservation<value_type> reservation = queue.reserve(scq::slot_id{1}, 2u);
+                                 reservation.get()[0] = 100;
+                                 reserved = true;
+
+                                 release_reservation.wait(false);
+
+                                 if (commit)
+                                     reservation.commit(1u);
+                             }};
+
+        reserved.wait(false);
+
+        std::atomic_bool closed{false};
+        std::thread closing_thread{[&]()
+                                   {
+                                       queue.close();
+                                       closed = true;
+                                   }};
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        EXPECT_FALSE(closed);
+
+        release_reservation = true;
+        release_reservation.notify_one();
+
+        producer.join();
+        closing_thread.join();
+        EXPECT_TRUE(closed);
+
+        std::vector<value_type> dequeued_values{};
+        for (scq::cart_future<value_type> cart = queue.dequeue(); cart.valid(); cart = queue.dequeue())
+            for (value_type value : cart.get().second)
+                dequeued_values.push_back(value);
+
+        std::ranges::sort(dequeued_values);
+        EXPECT_EQ(dequeued_values, commit ? (std::vector<value_type>{7, 100}) : (std::vector<value_type>{7}));
+    }
+}
+
+TEST(multiple_item_cart_reserve, concurrent_reservations)
+{
+    using value_type = size_t;
+
+    size_t const slot_count = 3u;
+    size_t const producer_count = 4u;
+    size_t const values_per_producer = 1000u;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = slot_count, .carts = slot_count * 2u, .capacity = 7}};
+
+    std::vector<std::thread> producers{};
+    for (size_t producer = 0u; producer < producer_count; ++producer)
+    {
+        producers.emplace_back(
+            [&queue, producer]()
+            {
+                size_t value = producer * values_per_producer;
+                size_t const end = value + values_per_producer;
+
+                while (value < end)
+                {
+                    scq::cart_reservation<value_type> reservation =
+                        queue.reserve(scq::slot_id{value % slot_count}, 5u);
+                    std::span<value_type> memory_region = reservation.get();
+
+                    size_t count = std::min(memory_region.size(), end - value);
+                    for (size_t i = 0u; i < count; ++i)
+                        memory_region[i] = value++;
+
+                    reservation.commit(count);
+                }
+            });
+    }
+
+    std::vector<value_type> dequeued_values{};
+    std::thread consumer{[&queue, &dequeued_values]()
+                         {
+                             for (scq::cart_future<value_type> cart = queue.dequeue(); cart.valid();
+                                  cart = queue.dequeue())
+                             {
+                                 std::span<value_type> memory_region = cart.get().second;
+                                 dequeued_values.insert(dequeued_values.end(),
+                                                        memory_region.begin(),
+                                                        memory_region.end());
+                             }
+                         }};
+
+    for (std::thread & producer : producers)
+        producer.join();
+
+    queue.close();
+    consumer.join();
+
+    std::vector<value_type> expected_values(producer_count * values_per_producer);
+    std::iota(expected_values.begin(), expected_values.end(), 0u);
+
+    std::ranges::sort(dequeued_values);
+    EXPECT_EQ(dequeued_values, expected_values);
+}
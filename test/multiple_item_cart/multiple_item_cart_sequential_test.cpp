@@ -11,18 +11,25 @@
 #include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, cart_capacity
 
 #include "../concurrent_cross_off_list.hpp" // for concurrent_cross_off_list
+#include "../slotted_cart_queue_types.hpp"  // for slotted_cart_queue_types, slotted_cart_queue_type_names, cart_futu...
 
-TEST(multiple_item_cart_sequential, single_cart_enqueue_dequeue)
+template <typename queue_t>
+class multiple_item_cart_sequential : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(multiple_item_cart_sequential, slotted_cart_queue_types<int>, slotted_cart_queue_type_names);
+
+TYPED_TEST(multiple_item_cart_sequential, single_cart_enqueue_dequeue)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     queue.enqueue(scq::slot_id{1}, value_type{100});
     queue.enqueue(scq::slot_id{1}, value_type{101});
 
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -36,7 +43,7 @@ TEST(multiple_item_cart_sequential, single_cart_enqueue_dequeue)
     queue.enqueue(scq::slot_id{2}, value_type{201});
 
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -47,11 +54,11 @@ TEST(multiple_item_cart_sequential, single_cart_enqueue_dequeue)
     }
 }
 
-TEST(multiple_item_cart_sequential, multiple_enqueue_dequeue)
+TYPED_TEST(multiple_item_cart_sequential, multiple_enqueue_dequeue)
 {
     using value_type = int;
 
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 2}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -71,7 +78,7 @@ TEST(multiple_item_cart_sequential, multiple_enqueue_dequeue)
 
     for (int i = 0; i < 6 / 2; ++i)
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
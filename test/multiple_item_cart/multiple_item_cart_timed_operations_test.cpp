@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <chrono>  // for milliseconds, steady_clock
+#include <cstddef> // for size_t
+#include <memory>  // for unique_ptr, make_unique
+#include <thread>  // for thread, sleep_for
+#include <utility> // for pair
+#include <vector>  // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, queue_op_status
+
+#include "../concurrent_cross_off_list.hpp" // for concurrent_cross_off_list
+
+static constexpr std::chrono::milliseconds wait_time(10);
+
+TEST(multiple_item_cart_timed_operations, dequeue_for_timeout)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    auto start = std::chrono::steady_clock::now();
+
+    scq::cart_future<value_type> cart{};
+    EXPECT_EQ(queue.dequeue_for(cart, wait_time), scq::queue_op_status::timeout);
+    EXPECT_FALSE(cart.valid());
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, wait_time);
+
+    queue.close();
+
+    EXPECT_EQ(queue.dequeue_for(cart, wait_time), scq::queue_op_status::closed);
+    EXPECT_FALSE(cart.valid());
+}
+
+TEST(multiple_item_cart_timed_operations, dequeue_until_cart_becomes_full)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    std::thread enqueue_thread{[&queue]
+                               {
+                                   std::this_thread::sleep_for(wait_time);
+                                   queue.enqueue(scq::slot_id{1}, value_type{100});
+                                   queue.enqueue(scq::slot_id{1}, value_type{101});
+                               }};
+
+    scq::cart_future<value_type> cart{};
+    EXPECT_EQ(queue.dequeue_until(cart, std::chrono::steady_clock::now() + std::chrono::seconds{60}),
+              scq::queue_op_status::ok);
+
+    enqueue_thread.join();
+
+    EXPECT_TRUE(cart.valid());
+    std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+    EXPECT_EQ(cart_data.first.value, 1u);
+    EXPECT_EQ(cart_data.second.size(), 2u);
+}
+
+TEST(multiple_item_cart_timed_operations, enqueue_for_timeout)
+{
+    using value_type = std::unique_ptr<int>;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 1, .carts = 1, .capacity = 1}};
+
+    EXPECT_EQ(queue.enqueue_for(scq::slot_id{0}, std::make_unique<int>(100), wait_time), scq::queue_op_status::ok);
+
+    // the only cart is full
+    auto start = std::chrono::steady_clock::now();
+
+    value_type value = std::make_unique<int>(101);
+    EXPECT_EQ(queue.enqueue_for(scq::slot_id{0}, std::move(value), wait_time), scq::queue_op_status::timeout);
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, wait_time);
+
+    // the value was not moved from
+    EXPECT_NE(value, nullptr);
+
+    // a consumer releases the full cart while the producer waits
+    std::thread dequeue_thread{[&queue]
+                               {
+                                   std::this_thread::sleep_for(wait_time);
+                                   scq::cart_future<value_type> cart = queue.dequeue();
+                                   EXPECT_EQ(*cart.get().second[0], 100);
+                               }};
+
+    EXPECT_EQ(queue.enqueue_until(scq::slot_id{0},
+                                  std::move(value),
+                                  std::chrono::steady_clock::now() + std::chrono::seconds{60}),
+              scq::queue_op_status::ok);
+    EXPECT_EQ(value, nullptr);
+
+    dequeue_thread.join();
+}
+
+TEST(multiple_item_cart_timed_operations, enqueue_for_after_close)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    queue.close();
+
+    value_type const value{100};
+    EXPECT_EQ(queue.enqueue_for(scq::slot_id{1}, value, wait_time), scq::queue_op_status::closed);
+}
+
+TEST(multiple_item_cart_timed_operations, multiple_producer_single_slot)
+{
+    using value_type = int;
+
+    static constexpr size_t thread_count{4};
+    static constexpr size_t value_count{1000};
+
+    // the producers of the slot compete for a single cart; timed out producers retry
+    scq::slotted_cart_queue<value_type> queue{{.slots = 1, .carts = 1, .capacity = 4}};
+
+    // expected set contains all (expected) results; after the test which set should be empty (each matching result will
+    // be crossed out)
+    concurrent_cross_off_list<std::pair<size_t, value_type>> expected{};
+    for (size_t thread_id = 0; thread_id < thread_count; ++thread_id)
+        for (size_t i = 0; i < value_count; ++i)
+            expected.insert(std::pair<size_t, value_type>{0, static_cast<value_type>(thread_id * value_count + i)});
+
+    std::vector<std::thread> enqueue_threads{};
+    for (size_t thread_id = 0; thread_id < thread_count; ++thread_id)
+    {
+        enqueue_threads.emplace_back(
+            [thread_id, &queue]
+            {
+                for (size_t i = 0; i < value_count; ++i)
+                {
+                    value_type const value = static_cast<value_type>(thread_id * value_count + i);
+                    scq::queue_op_status status{};
+
+                    while ((status = queue.enqueue_for(scq::slot_id{0}, value, std::chrono::microseconds{50}))
+                           == scq::queue_op_status::timeout)
+                    {}
+
+                    EXPECT_EQ(status, scq::queue_op_status::ok);
+                }
+            });
+    }
+
+    std::thread dequeue_thread{[&queue, &expected]
+                               {
+                                   while (true)
+                                   {
+                                       scq::cart_future<value_type> cart{};
+                                       scq::queue_op_status status =
+                                           queue.dequeue_for(cart, std::chrono::microseconds{50});
+
+                                       if (status == scq::queue_op_status::closed)
+                                           break;
+
+                                       if (status == scq::queue_op_status::timeout)
+                                           continue;
+
+                                       std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+
+                                       for (auto && value : cart_data.second)
+                                       {
+                                           EXPECT_TRUE(expected.cross_off({cart_data.first.value, value}));
+                                       }
+                                   }
+                               }};
+
+    for (auto && enqueue_thread : enqueue_threads)
+        enqueue_thread.join();
+
+    queue.close();
+
+    dequeue_thread.join();
+
+    // all results seen
+    EXPECT_TRUE(expected.empty());
+}
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <cstddef> // for size_t
+#include <memory>  // for unique_ptr, make_unique
+#include <thread>  // for thread, yield
+#include <utility> // for pair
+#include <vector>  // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, queue_op_status
+
+#include "../concurrent_cross_off_list.hpp" // for concurrent_cross_off_list
+
+TEST(multiple_item_cart_try_operations, try_dequeue_empty_queue)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    scq::cart_future<value_type> cart{};
+    EXPECT_EQ(queue.try_dequeue(cart), scq::queue_op_status::would_block);
+    EXPECT_FALSE(cart.valid());
+
+    // a half-filled cart is not available before the queue was closed
+    EXPECT_EQ(queue.try_enqueue(scq::slot_id{1}, value_type{100}), scq::queue_op_status::ok);
+    EXPECT_EQ(queue.try_dequeue(cart), scq::queue_op_status::would_block);
+
+    queue.close();
+
+    EXPECT_EQ(queue.try_dequeue(cart), scq::queue_op_status::ok);
+    EXPECT_TRUE(cart.valid());
+    EXPECT_EQ(cart.get().second.size(), 1u);
+    EXPECT_EQ(cart.get().second[0], value_type{100});
+
+    scq::cart_future<value_type> no_cart{};
+    EXPECT_EQ(queue.try_dequeue(no_cart), scq::queue_op_status::closed);
+    EXPECT_FALSE(no_cart.valid());
+}
+
+TEST(multiple_item_cart_try_operations, try_enqueue_all_carts_full)
+{
+    using value_type = std::unique_ptr<int>;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 2, .carts = 2, .capacity = 2}};
+
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(queue.try_enqueue(scq::slot_id{i % 2u}, std::make_unique<int>(100 + i)), scq::queue_op_status::ok);
+
+    // both carts are full
+    value_type value = std::make_unique<int>(104);
+    EXPECT_EQ(queue.try_enqueue(scq::slot_id{0}, std::move(value)), scq::queue_op_status::would_block);
+    EXPECT_EQ(queue.try_enqueue(scq::slot_id{1}, std::move(value)), scq::queue_op_status::would_block);
+
+    // the value was not moved from
+    EXPECT_NE(value, nullptr);
+
+    {
+        scq::cart_future<value_type> cart{};
+        EXPECT_EQ(queue.try_dequeue(cart), scq::queue_op_status::ok);
+        EXPECT_EQ(cart.get().second.size(), 2u);
+    }
+
+    // the processed cart can be used again
+    EXPECT_EQ(queue.try_enqueue(scq::slot_id{0}, std::move(value)), scq::queue_op_status::ok);
+    EXPECT_EQ(value, nullptr);
+}
+
+TEST(multiple_item_cart_try_operations, try_enqueue_after_close)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 2}};
+
+    EXPECT_EQ(queue.try_enqueue(scq::slot_id{1}, value_type{100}), scq::queue_op_status::ok);
+
+    queue.close();
+
+    value_type const value{101};
+    EXPECT_EQ(queue.try_enqueue(scq::slot_id{1}, value), scq::queue_op_status::closed);
+    EXPECT_EQ(queue.try_enqueue(scq::slot_id{2}, value), scq::queue_op_status::closed);
+}
+
+TEST(multiple_item_cart_try_operations, multiple_producer_multiple_consumer)
+{
+    using value_type = int;
+
+    static constexpr size_t thread_count{4};
+    static constexpr size_t value_count{1000};
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = thread_count, .carts = thread_count, .capacity = 4}};
+
+    // expected set contains all (expected) results; after the test which set should be empty (each matching result will
+    // be crossed out)
+    concurrent_cross_off_list<std::pair<size_t, value_type>> expected{};
+    for (size_t thread_id = 0; thread_id < thread_count; ++thread_id)
+        for (size_t i = 0; i < value_count; ++i)
+            expected.insert(std::pair<size_t, value_type>{thread_id, i});
+
+    std::vector<std::thread> enqueue_threads{};
+    for (size_t thread_id = 0; thread_id < thread_count; ++thread_id)
+    {
+        enqueue_threads.emplace_back(
+            [thread_id, &queue]
+            {
+                for (size_t i = 0; i < value_count; ++i)
+                {
+                    value_type const value = static_cast<value_type>(i);
+                    scq::queue_op_status status{};
+
+                    // every slot has at most one cart, i.e. the producers wait for the consumers
+                    while ((status = queue.try_enqueue(scq::slot_id{thread_id}, value))
+                           == scq::queue_op_status::would_block)
+                        std::this_thread::yield();
+
+                    EXPECT_EQ(status, scq::queue_op_status::ok);
+                }
+            });
+    }
+
+    std::vector<std::thread> dequeue_threads{};
+    for (size_t thread_id = 0; thread_id < thread_count; ++thread_id)
+    {
+        dequeue_threads.emplace_back(
+            [&queue, &expected]
+            {
+                while (true)
+                {
+                    scq::cart_future<value_type> cart{};
+                    scq::queue_op_status status = queue.try_dequeue(cart);
+
+                    if (status == scq::queue_op_status::closed)
+                        break;
+
+                    if (status == scq::queue_op_status::would_block)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
+
+                    for (auto && value : cart_data.second)
+                    {
+                        EXPECT_TRUE(expected.cross_off({cart_data.first.value, value}));
+                    }
+                }
+            });
+    }
+
+    for (auto && enqueue_thread : enqueue_threads)
+        enqueue_thread.join();
+
+    queue.close();
+
+    for (auto && dequeue_thread : dequeue_threads)
+        dequeue_thread.join();
+
+    // all results seen
+    EXPECT_TRUE(expected.empty());
+}
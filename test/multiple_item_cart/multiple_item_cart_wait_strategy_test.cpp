@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for AssertionResult, Message, Test, TestPartResult, CmpHelperEQ, Cmp...
+
+#include <atomic>  // for atomic
+#include <chrono>  // for milliseconds, steady_clock
+#include <cstddef> // for size_t
+#include <thread>  // for thread
+#include <vector>  // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slot_id, span, slotted_cart_queue, cart_future, wait_strategy
+
+class multiple_item_cart_wait_strategy : public ::testing::TestWithParam<scq::wait_strategy>
+{};
+
+TEST_P(multiple_item_cart_wait_strategy, concurrent)
+{
+    using value_type = size_t;
+
+    size_t const slot_count = 5u;
+    size_t const producer_count = 3u;
+    size_t const consumer_count = 3u;
+    size_t const values_per_producer = 1000u;
+
+    scq::slotted_cart_queue<value_type> queue{
+        {.slots = slot_count, .carts = slot_count + 1u, .capacity = 3, .wait_strategy = GetParam()}};
+
+    std::atomic<size_t> value_sum{};
+    std::atomic<size_t> value_count{};
+
+    std::vector<std::thread> consumers{};
+    for (size_t consumer_id = 0u; consumer_id < consumer_count; ++consumer_id)
+    {
+        consumers.emplace_back(
+            [&]()
+            {
+                while (true)
+                {
+                    scq::cart_future<value_type> cart = queue.dequeue();
+
+                    if (!cart.valid())
+                        break;
+
+                    auto [slot, memory_region] = cart.get();
+                    for (value_type value : memory_region)
+                    {
+                        EXPECT_EQ(value % slot_count, slot.value);
+                        value_sum += value;
+                        ++value_count;
+                    }
+                }
+            });
+    }
+
+    std::vector<std::thread> producers{};
+    for (size_t producer_id = 0u; producer_id < producer_count; ++producer_id)
+    {
+        producers.emplace_back(
+            [&queue, producer_id]()
+            {
+                for (size_t i = 0u; i < values_per_producer; ++i)
+                {
+                    size_t const value = producer_id * values_per_producer + i;
+                    queue.enqueue(scq::slot_id{value % slot_count}, value);
+                }
+            });
+    }
+
+    for (std::thread & producer : producers)
+        producer.join();
+
+    queue.close();
+
+    for (std::thread & consumer : consumers)
+        consumer.join();
+
+    size_t const total_count = producer_count * values_per_producer;
+    EXPECT_EQ(value_count.load(), total_count);
+    EXPECT_EQ(value_sum.load(), total_count * (total_count - 1u) / 2u);
+}
+
+TEST_P(multiple_item_cart_wait_strategy, deadline)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 1, .carts = 1, .capacity = 1, .wait_strategy = GetParam()}};
+
+    // spinning threads give up once the deadline passed as well
+    scq::cart_future<value_type> cart{};
+    auto const start = std::chrono::steady_clock::now();
+    EXPECT_EQ(queue.dequeue_for(cart, std::chrono::milliseconds{20}), scq::queue_op_status::timeout);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{20});
+
+    queue.enqueue(scq::slot_id{0}, 1);
+    EXPECT_EQ(queue.enqueue_for(scq::slot_id{0}, 2, std::chrono::milliseconds{20}), scq::queue_op_status::timeout);
+
+    EXPECT_EQ(queue.dequeue_for(cart, std::chrono::milliseconds{20}), scq::queue_op_status::ok);
+    EXPECT_EQ(cart.get().second[0], 1);
+}
+
+TEST_P(multiple_item_cart_wait_strategy, close_releases_waiting_consumers)
+{
+    using value_type = int;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = 2, .carts = 2, .capacity = 2, .wait_strategy = GetParam()}};
+
+    std::thread consumer{[&queue]()
+                         {
+                             EXPECT_TRUE(queue.dequeue().valid());
+                             EXPECT_FALSE(queue.dequeue().valid());
+                         }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    queue.enqueue(scq::slot_id{1}, 1);
+    queue.close();
+    consumer.join();
+}
+
+INSTANTIATE_TEST_SUITE_P(wait_strategies,
+                         multiple_item_cart_wait_strategy,
+                         ::testing::Values(scq::wait_strategy::block,
+                                           scq::wait_strategy::spin,
+                                           scq::wait_strategy::spin_then_yield,
+                                           scq::wait_strategy::spin_then_block));
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for Test, TestInfo, Message, TEST, EXPECT_EQ, TestPartResult
+
+#include <cstddef>    // for size_t
+#include <filesystem> // for path, temp_directory_path, create_directories, remove_all
+#include <fstream>    // for ofstream
+#include <optional>   // for optional
+#include <string>     // for string, to_string
+#include <thread>     // for thread
+#include <vector>     // for vector
+
+#include <unistd.h> // for getpid
+
+#include <scq/detail/lock_free_cart_ids.hpp> // for cart_id_stack
+#include <scq/detail/numa_topology.hpp>      // for parse_cpu_list, read_numa_topology, system_numa_topology
+#include <scq/slotted_cart_queue.hpp>        // for slotted_cart_queue, slot_id, cart_future
+
+TEST(numa_topology_test, parse_cpu_list)
+{
+    EXPECT_EQ(scq::detail::parse_cpu_list("0\n"), (std::vector<size_t>{0u}));
+    EXPECT_EQ(scq::detail::parse_cpu_list("0-3,8,10-11"), (std::vector<size_t>{0u, 1u, 2u, 3u, 8u, 10u, 11u}));
+    EXPECT_TRUE(scq::detail::parse_cpu_list("").empty());
+    EXPECT_TRUE(scq::detail::parse_cpu_list("\n").empty());
+    EXPECT_TRUE(scq::detail::parse_cpu_list("3-1").empty());
+    EXPECT_TRUE(scq::detail::parse_cpu_list("0-x").empty());
+}
+
+TEST(numa_topology_test, read_numa_topology)
+{
+    std::filesystem::path const node_directory =
+        std::filesystem::temp_directory_path() / ("scq_numa_topology_test_" + std::to_string(getpid()));
+
+    auto write_cpu_list = [&](std::string const & node, std::string const & cpu_list)
+    {
+        std::filesystem::create_directories(node_directory / node);
+        std::ofstream{node_directory / node / "cpulist"} << cpu_list << '\n';
+    };
+
+    write_cpu_list("node2", "2-3");
+    write_cpu_list("node0", "0-1");
+    write_cpu_list("node1", ""); // memory-only node
+    write_cpu_list("node", "4");
+    write_cpu_list("nodes", "5");
+    std::ofstream{node_directory / "online"} << "0-2\n";
+
+    scq::detail::numa_topology const topology = scq::detail::read_numa_topology(node_directory);
+    std::filesystem::remove_all(node_directory);
+
+    ASSERT_EQ(topology.node_count(), 2u);
+    EXPECT_EQ(topology.node_cpus[0], (std::vector<size_t>{0u, 1u}));
+    EXPECT_EQ(topology.node_cpus[1], (std::vector<size_t>{2u, 3u}));
+    EXPECT_EQ(topology.cpu_nodes, (std::vector<size_t>{0u, 0u, 1u, 1u}));
+}
+
+TEST(numa_topology_test, missing_node_directory)
+{
+    scq::detail::numa_topology const topology =
+        scq::detail::read_numa_topology(std::filesystem::temp_directory_path() / "scq_numa_topology_test_missing");
+
+    EXPECT_EQ(topology.node_count(), 1u);
+    EXPECT_EQ(topology.current_node(), 0u);
+}
+
+TEST(numa_topology_test, system_numa_topology)
+{
+    scq::detail::numa_topology const & topology = scq::detail::system_numa_topology();
+
+    EXPECT_GE(topology.node_count(), 1u);
+    EXPECT_LT(topology.current_node(), topology.node_count());
+}
+
+// Each pool is a stack of its own; a pop takes from the preferred pool first and from the others in turn.
+TEST(numa_topology_test, cart_id_stack_pools)
+{
+    scq::detail::cart_id_stack stack{6u, 3u};
+
+    for (size_t cart_id = 0u; cart_id < 6u; ++cart_id)
+        stack.push(cart_id, cart_id / 2u);
+
+    EXPECT_EQ(stack.pop(1u), std::optional<size_t>{3u});
+    EXPECT_EQ(stack.pop(1u), std::optional<size_t>{2u});
+    EXPECT_EQ(stack.pop(1u), std::optional<size_t>{5u}); // pool 2 is next in turn
+    EXPECT_EQ(stack.pop(0u), std::optional<size_t>{1u});
+
+    stack.push(3u, 1u);
+    EXPECT_EQ(stack.pop(2u), std::optional<size_t>{4u});
+    EXPECT_EQ(stack.pop(2u), std::optional<size_t>{0u});
+    EXPECT_EQ(stack.pop(2u), std::optional<size_t>{3u});
+
+    EXPECT_TRUE(stack.empty());
+    EXPECT_EQ(stack.pop(0u), std::nullopt);
+}
+
+// On systems with a single node, numa_aware has no effect; either way the queue hands out all elements.
+TEST(numa_topology_test, numa_aware_queue)
+{
+    using value_type = size_t;
+
+    size_t const slot_count = 4u;
+    size_t const producer_count = 3u;
+    size_t const values_per_producer = 1000u;
+
+    scq::slotted_cart_queue<value_type> queue{{.slots = slot_count, .carts = 9, .capacity = 5, .numa_aware = true}};
+
+    size_t value_sum{};
+
+    std::thread consumer{[&]()
+                         {
+                             while (true)
+                             {
+                                 scq::cart_future<value_type> cart = queue.dequeue();
+
+                                 if (!cart.valid())
+                                     break;
+
+                                 for (value_type value : cart.get().second)
+                                     value_sum += value;
+                             }
+                         }};
+
+    std::vector<std::thread> producers{};
+    for (size_t producer_id = 0u; producer_id < producer_count; ++producer_id)
+    {
+        producers.emplace_back(
+            [&queue, producer_id]()
+            {
+                for (value_type value = 0u; value < values_per_producer; ++value)
+                    queue.enqueue(scq::slot_id{(producer_id + value) % slot_count}, value);
+            });
+    }
+
+    for (std::thread & producer : producers)
+        producer.join();
+
+    queue.close();
+    consumer.join();
+
+    EXPECT_EQ(value_sum, producer_count * values_per_producer * (values_per_producer - 1u) / 2u);
+}
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <gtest/gtest.h> // for Test, TestInfo, Message, TEST, EXPECT_EQ, TestPartResult
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint64_t, int64_t
+#include <numeric> // for inclusive_scan
+#include <random>  // for mt19937_64, uniform_int_distribution
+#include <vector>  // for vector
+
+#include <scq/detail/partition_kernels.hpp> // for partition_isa, is_supported, get_partition_kernels
+
+// Compares the kernels of each instruction set the CPU supports against a reference partitioning.
+template <typename value_t>
+void check_partition_kernels(size_t slot_count, size_t value_count)
+{
+    std::mt19937_64 engine{slot_count * value_count};
+    std::uniform_int_distribution<size_t> slot_distribution{0u, slot_count - 1u};
+
+    std::vector<size_t> slot_ids(value_count);
+    std::vector<value_t> values(value_count);
+    for (size_t i = 0; i < value_count; ++i)
+    {
+        slot_ids[i] = slot_distribution(engine);
+        values[i] = static_cast<value_t>(engine());
+    }
+
+    // reference: counting sort that keeps the relative order of the values of each slot
+    std::vector<size_t> expected_offsets(slot_count + 1u);
+    for (size_t slot_id : slot_ids)
+        ++expected_offsets[slot_id + 1u];
+    std::inclusive_scan(expected_offsets.begin(), expected_offsets.end(), expected_offsets.begin());
+
+    std::vector<value_t> expected_values(value_count);
+    {
+        std::vector<size_t> next_positions(expected_offsets.begin(), expected_offsets.end() - 1);
+        for (size_t i = 0; i < value_count; ++i)
+            expected_values[next_positions[slot_ids[i]]++] = values[i];
+    }
+
+    for (scq::detail::partition_isa isa :
+         {scq::detail::partition_isa::scalar, scq::detail::partition_isa::avx2, scq::detail::partition_isa::avx512})
+    {
+        if (!scq::detail::is_supported(isa))
+            continue;
+
+        scq::detail::partition_kernels<value_t> kernels = scq::detail::get_partition_kernels<value_t>(isa);
+        EXPECT_EQ(kernels.isa, isa);
+
+        std::vector<size_t> slot_offsets(slot_count + 1u);
+        kernels.count_slots(slot_ids.data(), value_count, slot_offsets.data() + 1);
+        std::inclusive_scan(slot_offsets.begin(), slot_offsets.end(), slot_offsets.begin());
+
+        EXPECT_EQ(slot_offsets, expected_offsets) << "isa: " << static_cast<int>(isa);
+
+        std::vector<value_t> partitioned_values(value_count);
+        kernels.partition_values(slot_ids.data(),
+                                 values.data(),
+                                 value_count,
+                                 slot_offsets.data(),
+                                 slot_count,
+                                 partitioned_values.data());
+
+        EXPECT_EQ(partitioned_values, expected_values) << "isa: " << static_cast<int>(isa);
+    }
+}
+
+TEST(partition_kernels_test, few_slots)
+{
+    // compress path
+    for (size_t slot_count : {1u, 2u, 3u, 4u})
+        for (size_t value_count : {0u, 1u, 7u, 8u, 9u, 1001u})
+            check_partition_kernels<uint64_t>(slot_count, value_count);
+}
+
+TEST(partition_kernels_test, many_slots)
+{
+    // scatter path; few slots produce many conflicts
+    for (size_t slot_count : {5u, 9u, 64u, 1000u})
+        for (size_t value_count : {0u, 1u, 7u, 8u, 9u, 1001u, 100000u})
+            check_partition_kernels<uint64_t>(slot_count, value_count);
+}
+
+TEST(partition_kernels_test, signed_values)
+{
+    check_partition_kernels<int64_t>(4u, 1001u);
+    check_partition_kernels<int64_t>(100u, 1001u);
+}
+
+TEST(partition_kernels_test, selected_kernels_are_supported)
+{
+    EXPECT_TRUE(scq::detail::is_supported(scq::detail::select_partition_kernels<uint64_t>().isa));
+}
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <benchmark/benchmark.h> // for State, BENCHMARK_CAPTURE, DoNotOptimize, Counter
+
+#include <algorithm> // for ranges::sort
+#include <chrono>    // for steady_clock, duration_cast, nanoseconds
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+#include <mutex>     // for mutex, scoped_lock
+#include <random>    // for mt19937_64, uniform_int_distribution, bernoulli_distribution
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slotted_cart_queue, slot_id, cart_order
+
+static constexpr size_t slot_count{64};
+static constexpr size_t cart_count{256};
+static constexpr size_t cart_capacity{16};
+static constexpr size_t producer_count{4};
+static constexpr size_t consumer_count{2};
+static constexpr size_t elements_per_producer{1u << 15};
+// every other element goes to slot 0, the remaining elements are spread over all slots
+static constexpr double hot_slot_share{0.5};
+
+static uint64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Each element is the time it was enqueued at. The latency of a cart is the time from enqueueing its oldest element
+// until a consumer dequeued the cart. The consumers are slower than the producers, such that full carts pile up and
+// the order in which they are handed out determines their latency.
+static void cart_order_latency(benchmark::State & state, scq::cart_order cart_order)
+{
+    using value_type = uint64_t;
+
+    std::vector<std::vector<size_t>> producer_slots(producer_count);
+    for (size_t producer_id = 0; producer_id < producer_count; ++producer_id)
+    {
+        std::mt19937_64 engine{producer_id};
+        std::bernoulli_distribution hot_distribution{hot_slot_share};
+        std::uniform_int_distribution<size_t> slot_distribution{0u, slot_count - 1u};
+
+        producer_slots[producer_id].resize(elements_per_producer);
+        for (size_t & slot : producer_slots[producer_id])
+            slot = hot_distribution(engine) ? 0u : slot_distribution(engine);
+    }
+
+    std::vector<uint64_t> latencies{};
+
+    for (auto _ : state)
+    {
+        scq::slotted_cart_queue<value_type> queue{
+            {.slots = slot_count, .carts = cart_count, .capacity = cart_capacity, .cart_order = cart_order}};
+
+        std::mutex latencies_mutex{};
+
+        std::vector<std::thread> dequeue_threads{};
+        for (size_t consumer_id = 0; consumer_id < consumer_count; ++consumer_id)
+        {
+            dequeue_threads.emplace_back(
+                [&queue, &latencies, &latencies_mutex]
+                {
+                    std::vector<uint64_t> consumer_latencies{};
+
+                    while (true)
+                    {
+                        scq::cart_future<value_type> cart = queue.dequeue();
+
+                        if (!cart.valid())
+                            break;
+
+                        std::span<value_type> values = cart.get().second;
+                        consumer_latencies.push_back(now() - *std::ranges::min_element(values));
+
+                        // simulated processing of the cart
+                        uint64_t hash{};
+                        for (size_t round = 0; round < 64u; ++round)
+                            for (value_type value : values)
+                                benchmark::DoNotOptimize(hash ^= value * 0x9E3779B97F4A7C15ULL + round);
+                    }
+
+                    std::scoped_lock lock{latencies_mutex};
+                    latencies.insert(latencies.end(), consumer_latencies.begin(), consumer_latencies.end());
+                });
+        }
+
+        std::vector<std::thread> enqueue_threads{};
+        for (size_t producer_id = 0; producer_id < producer_count; ++producer_id)
+        {
+            enqueue_threads.emplace_back(
+                [&queue, &slots = producer_slots[producer_id]]
+                {
+                    for (size_t slot : slots)
+                        queue.enqueue(scq::slot_id{slot}, now());
+                });
+        }
+
+        for (auto && enqueue_thread : enqueue_threads)
+            enqueue_thread.join();
+
+        queue.close();
+
+        for (auto && dequeue_thread : dequeue_threads)
+            dequeue_thread.join();
+    }
+
+    std::ranges::sort(latencies);
+    auto percentile = [&latencies](double p)
+    {
+        return latencies.empty() ? 0.0 : static_cast<double>(latencies[(latencies.size() - 1u) * p]) / 1000.0;
+    };
+
+    state.counters["p50_us"] = percentile(0.50);
+    state.counters["p99_us"] = percentile(0.99);
+    state.counters["max_us"] = percentile(1.00);
+    state.SetItemsProcessed(state.iterations() * producer_count * elements_per_producer);
+}
+
+BENCHMARK_CAPTURE(cart_order_latency, lifo, scq::cart_order::lifo)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(cart_order_latency, fifo, scq::cart_order::fifo)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(cart_order_latency, round_robin, scq::cart_order::round_robin)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
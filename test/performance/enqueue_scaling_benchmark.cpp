@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <benchmark/benchmark.h> // for State, BENCHMARK_CAPTURE, DoNotOptimize
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint64_t
+#include <random>  // for mt19937_64, uniform_int_distribution
+#include <thread>  // for thread
+#include <vector>  // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slotted_cart_queue, slot_id
+
+static constexpr size_t slot_count{256};
+static constexpr size_t cart_count{1024};
+static constexpr size_t cart_capacity{64};
+static constexpr size_t consumer_count{4};
+static constexpr size_t elements_per_producer{1u << 16};
+
+// Each producer enqueues elements_per_producer elements into random slots out of the first used_slot_count slots;
+// the consumers only drain the queue.
+static void enqueue_scaling(benchmark::State & state, size_t lock_stripes, size_t used_slot_count)
+{
+    using value_type = uint64_t;
+
+    size_t const producer_count = state.range(0);
+
+    std::vector<std::vector<size_t>> producer_slots(producer_count);
+    for (size_t producer_id = 0; producer_id < producer_count; ++producer_id)
+    {
+        std::mt19937_64 engine{producer_id};
+        std::uniform_int_distribution<size_t> distribution{0u, used_slot_count - 1u};
+
+        producer_slots[producer_id].resize(elements_per_producer);
+        for (size_t & slot : producer_slots[producer_id])
+            slot = distribution(engine);
+    }
+
+    for (auto _ : state)
+    {
+        scq::slotted_cart_queue<value_type> queue{
+            {.slots = slot_count, .carts = cart_count, .capacity = cart_capacity, .lock_stripes = lock_stripes}};
+
+        std::vector<std::thread> dequeue_threads{};
+        for (size_t consumer_id = 0; consumer_id < consumer_count; ++consumer_id)
+        {
+            dequeue_threads.emplace_back(
+                [&queue]
+                {
+                    while (true)
+                    {
+                        scq::cart_future<value_type> cart = queue.dequeue();
+
+                        if (!cart.valid())
+                            break;
+
+                        benchmark::DoNotOptimize(cart.get().second.data());
+                    }
+                });
+        }
+
+        std::vector<std::thread> enqueue_threads{};
+        for (size_t producer_id = 0; producer_id < producer_count; ++producer_id)
+        {
+            enqueue_threads.emplace_back(
+                [&queue, &slots = producer_slots[producer_id]]
+                {
+                    for (size_t i = 0; i < slots.size(); ++i)
+                        queue.enqueue(scq::slot_id{slots[i]}, static_cast<value_type>(i));
+                });
+        }
+
+        for (auto && enqueue_thread : enqueue_threads)
+            enqueue_thread.join();
+
+        queue.close();
+
+        for (auto && dequeue_thread : dequeue_threads)
+            dequeue_thread.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * producer_count * elements_per_producer);
+}
+
+// lock_stripes = 1 shares one lock between all slots.
+BENCHMARK_CAPTURE(enqueue_scaling, single_lock, 1u, slot_count)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(enqueue_scaling, lock_per_slot, 0u, slot_count)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+// All producers share one slot, i.e. they contend on the reservations of the same cart.
+BENCHMARK_CAPTURE(enqueue_scaling, hot_slot, 0u, 1u)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <benchmark/benchmark.h> // for State, BENCHMARK_CAPTURE, DoNotOptimize, ClobberMemory
+
+#include <algorithm> // for ranges::fill, ranges::transform
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+#include <numeric>   // for inclusive_scan
+#include <random>    // for mt19937_64, uniform_int_distribution
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include <scq/detail/partition_kernels.hpp> // for partition_isa, is_supported, get_partition_kernels
+#include <scq/slotted_cart_queue.hpp>       // for slotted_cart_queue, slot_id
+
+using value_type = uint64_t;
+
+static constexpr size_t batch_size{4096};
+static constexpr size_t batch_count{64};
+static constexpr size_t cart_capacity{256};
+
+struct batch_t
+{
+    std::vector<scq::slot_id> slots;
+    std::vector<value_type> values;
+};
+
+static batch_t make_batch(size_t slot_count, size_t batch_id)
+{
+    std::mt19937_64 engine{batch_id};
+    std::uniform_int_distribution<size_t> distribution{0u, slot_count - 1u};
+
+    batch_t batch{};
+    for (size_t i = 0; i < batch_size; ++i)
+    {
+        batch.slots.push_back(scq::slot_id{distribution(engine)});
+        batch.values.push_back(engine());
+    }
+    return batch;
+}
+
+enum class enqueue_mode
+{
+    per_element,
+    scatter,
+    simd_scatter
+};
+
+// A single producer enqueues batch_count batches of (slot, value) pairs; one consumer drains the queue.
+static void enqueue_batch(benchmark::State & state, enqueue_mode mode)
+{
+    size_t const slot_count = state.range(0);
+
+    std::vector<batch_t> batches{};
+    for (size_t batch_id = 0; batch_id < batch_count; ++batch_id)
+        batches.push_back(make_batch(slot_count, batch_id));
+
+    for (auto _ : state)
+    {
+        scq::slotted_cart_queue<value_type> queue{{.slots = slot_count,
+                                                   .carts = 2 * slot_count,
+                                                   .capacity = cart_capacity,
+                                                   .simd_scatter = mode == enqueue_mode::simd_scatter}};
+
+        std::thread dequeue_thread{[&queue]
+                                   {
+                                       for (auto cart = queue.dequeue(); cart.valid(); cart = queue.dequeue())
+                                           benchmark::DoNotOptimize(cart.get().second.data());
+                                   }};
+
+        for (batch_t const & batch : batches)
+        {
+            if (mode == enqueue_mode::per_element)
+            {
+                for (size_t i = 0; i < batch_size; ++i)
+                    queue.enqueue(batch.slots[i], batch.values[i]);
+            }
+            else
+            {
+                queue.enqueue_scatter(batch.slots, batch.values);
+            }
+        }
+
+        queue.close();
+        dequeue_thread.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_count * batch_size);
+}
+
+// Only the partitioning of one batch, i.e. counting pass, prefix sum and scatter into the partitioned buffer.
+static void partition_kernel(benchmark::State & state, scq::detail::partition_isa isa)
+{
+    if (!scq::detail::is_supported(isa))
+    {
+        state.SkipWithError("The CPU does not support this instruction set.");
+        return;
+    }
+
+    size_t const slot_count = state.range(0);
+    scq::detail::partition_kernels<value_type> const kernels = scq::detail::get_partition_kernels<value_type>(isa);
+
+    batch_t const batch = make_batch(slot_count, 0u);
+    std::vector<size_t> slot_ids(batch_size);
+    std::ranges::transform(batch.slots, slot_ids.begin(), &scq::slot_id::value);
+
+    std::vector<size_t> slot_offsets(slot_count + 1u);
+    std::vector<value_type> partitioned_values(batch_size);
+
+    for (auto _ : state)
+    {
+        std::ranges::fill(slot_offsets, 0u);
+        kernels.count_slots(slot_ids.data(), batch_size, slot_offsets.data() + 1);
+        std::inclusive_scan(slot_offsets.begin(), slot_offsets.end(), slot_offsets.begin());
+        kernels.partition_values(slot_ids.data(),
+                                 batch.values.data(),
+                                 batch_size,
+                                 slot_offsets.data(),
+                                 slot_count,
+                                 partitioned_values.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK_CAPTURE(enqueue_batch, per_element, enqueue_mode::per_element)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK_CAPTURE(enqueue_batch, scatter, enqueue_mode::scatter)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK_CAPTURE(enqueue_batch, simd_scatter, enqueue_mode::simd_scatter)->RangeMultiplier(4)->Range(4, 1024);
+
+BENCHMARK_CAPTURE(partition_kernel, scalar, scq::detail::partition_isa::scalar)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK_CAPTURE(partition_kernel, avx2, scq::detail::partition_isa::avx2)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK_CAPTURE(partition_kernel, avx512, scq::detail::partition_isa::avx512)->RangeMultiplier(4)->Range(4, 1024);
@@ -0,0 +1,250 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <benchmark/benchmark.h> // for State, BENCHMARK, BENCHMARK_TEMPLATE, DoNotOptimize, Counter
+
+#include <atomic>  // for atomic
+#include <cstddef> // for size_t
+#include <cstdint> // for uint64_t
+#include <cstdlib> // for getenv, strtoull
+#include <new>     // for hardware_destructive_interference_size
+#include <thread>  // for thread
+#include <vector>  // for vector
+
+#if defined(__linux__)
+#    include <linux/perf_event.h> // for perf_event_attr, PERF_TYPE_RAW, PERF_TYPE_HARDWARE, PERF_EVENT_IOC_ENABLE, ...
+#    include <sys/ioctl.h>        // for ioctl
+#    include <sys/syscall.h>      // for SYS_perf_event_open
+#    include <unistd.h>           // for syscall, read, close
+#endif
+
+#include <scq/lockfree_slotted_cart_queue.hpp> // for lockfree_slotted_cart_queue
+#include <scq/slotted_cart_queue.hpp>          // for slotted_cart_queue, slot_id
+
+static constexpr size_t cart_capacity{64};
+static constexpr size_t elements_per_producer{1u << 16};
+static constexpr size_t increments_per_thread{1u << 20};
+
+// Counts the HITM events, i.e. loads that hit a cache line that is modified in the cache of another core, of this
+// process and of all threads it starts while counting. The event is model specific: SCQ_HITM_EVENT sets its raw
+// encoding, e.g. 0x4d2 (MEM_LOAD_L3_HIT_RETIRED.XSNP_HITM) on Intel Skylake. Without it, the cache misses are counted
+// instead. If the counter cannot be opened (e.g. because of /proc/sys/kernel/perf_event_paranoid or in a container),
+// the benchmarks run without it.
+class hitm_counter
+{
+public:
+    hitm_counter()
+    {
+#if defined(__linux__)
+        perf_event_attr attributes{};
+        attributes.size = sizeof(attributes);
+        attributes.disabled = 1;
+        attributes.inherit = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+
+        if (char const * event = std::getenv("SCQ_HITM_EVENT"); event != nullptr)
+        {
+            attributes.type = PERF_TYPE_RAW;
+            attributes.config = std::strtoull(event, nullptr, 0);
+        }
+        else
+        {
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+        }
+
+        file_descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+    }
+
+    hitm_counter(hitm_counter const &) = delete;
+    hitm_counter & operator=(hitm_counter const &) = delete;
+
+    ~hitm_counter()
+    {
+#if defined(__linux__)
+        if (available())
+            close(file_descriptor);
+#endif
+    }
+
+    bool available() const
+    {
+        return file_descriptor >= 0;
+    }
+
+    void start()
+    {
+#if defined(__linux__)
+        if (available())
+        {
+            ioctl(file_descriptor, PERF_EVENT_IOC_RESET, 0);
+            ioctl(file_descriptor, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // The number of events since start().
+    uint64_t stop()
+    {
+        uint64_t count{};
+#if defined(__linux__)
+        if (available())
+        {
+            ioctl(file_descriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+            if (read(file_descriptor, &count, sizeof(count)) != sizeof(count))
+                count = 0u;
+        }
+#endif
+        return count;
+    }
+
+private:
+    int file_descriptor{-1};
+};
+
+static void report_hitm(benchmark::State & state, hitm_counter const & counter, uint64_t hitm_count, size_t op_count)
+{
+    if (counter.available())
+        state.counters["hitm_per_op"] = static_cast<double>(hitm_count) / static_cast<double>(op_count);
+    else
+        state.SetLabel("no perf counter");
+}
+
+// The counters of the threads either lie next to each other, like the hot members of the queues did before, or each
+// on a cache line of its own, like the hot members of the queues do now.
+struct packed_counter_t
+{
+    std::atomic<uint64_t> value{};
+};
+
+struct alignas(std::hardware_destructive_interference_size) padded_counter_t
+{
+    std::atomic<uint64_t> value{};
+};
+
+// Each of state.range(0) threads increments its own counter; only the layout of the counters differs.
+template <typename counter_t>
+static void adjacent_counters(benchmark::State & state)
+{
+    size_t const thread_count = state.range(0);
+
+    hitm_counter counter{};
+    uint64_t hitm_count{};
+
+    for (auto _ : state)
+    {
+        std::vector<counter_t> counters(thread_count);
+
+        counter.start();
+
+        std::vector<std::thread> threads{};
+        for (size_t thread_id = 0; thread_id < thread_count; ++thread_id)
+        {
+            threads.emplace_back(
+                [&value = counters[thread_id].value]
+                {
+                    for (size_t i = 0; i < increments_per_thread; ++i)
+                        value.fetch_add(1u, std::memory_order_relaxed);
+                });
+        }
+
+        for (auto && thread : threads)
+            thread.join();
+
+        hitm_count += counter.stop();
+        benchmark::DoNotOptimize(counters.data());
+    }
+
+    size_t const op_count = state.iterations() * thread_count * increments_per_thread;
+    report_hitm(state, counter, hitm_count, op_count);
+    state.SetItemsProcessed(op_count);
+}
+
+// Each of state.range(0) producers enqueues into a slot of its own, a single consumer drains the queue. Without false
+// sharing, the producers only share the cache lines of the carts queues, i.e. the HITM events per element should be
+// far below one.
+template <typename queue_t>
+static void queue_hitm(benchmark::State & state)
+{
+    using value_type = typename queue_t::value_type;
+
+    size_t const producer_count = state.range(0);
+
+    hitm_counter counter{};
+    uint64_t hitm_count{};
+
+    for (auto _ : state)
+    {
+        queue_t queue{{.slots = producer_count,
+                       .carts = 4u * producer_count,
+                       .capacity = cart_capacity,
+                       .cart_order = scq::cart_order::fifo}};
+
+        counter.start();
+
+        std::thread dequeue_thread{[&queue]
+                                   {
+                                       while (true)
+                                       {
+                                           typename queue_t::cart_future_type cart = queue.dequeue();
+
+                                           if (!cart.valid())
+                                               break;
+
+                                           benchmark::DoNotOptimize(cart.get().second.data());
+                                       }
+                                   }};
+
+        std::vector<std::thread> enqueue_threads{};
+        for (size_t producer_id = 0; producer_id < producer_count; ++producer_id)
+        {
+            enqueue_threads.emplace_back(
+                [&queue, producer_id]
+                {
+                    for (size_t i = 0; i < elements_per_producer; ++i)
+                        queue.enqueue(scq::slot_id{producer_id}, static_cast<value_type>(i));
+                });
+        }
+
+        for (auto && enqueue_thread : enqueue_threads)
+            enqueue_thread.join();
+
+        queue.close();
+        dequeue_thread.join();
+
+        hitm_count += counter.stop();
+    }
+
+    size_t const op_count = state.iterations() * producer_count * elements_per_producer;
+    report_hitm(state, counter, hitm_count, op_count);
+    state.SetItemsProcessed(op_count);
+}
+
+BENCHMARK_TEMPLATE(adjacent_counters, packed_counter_t)
+    ->RangeMultiplier(2)
+    ->Range(2, 8)
+    ->ArgName("threads")
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(adjacent_counters, padded_counter_t)
+    ->RangeMultiplier(2)
+    ->Range(2, 8)
+    ->ArgName("threads")
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(queue_hitm, scq::slotted_cart_queue<uint64_t>)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->ArgName("producers")
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(queue_hitm, scq::lockfree_slotted_cart_queue<uint64_t>)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->ArgName("producers")
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
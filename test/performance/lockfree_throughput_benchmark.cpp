@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <benchmark/benchmark.h> // for State, BENCHMARK_TEMPLATE, DoNotOptimize
+
+#include <cstddef> // for size_t
+#include <cstdint> // for uint64_t
+#include <random>  // for mt19937_64, uniform_int_distribution
+#include <thread>  // for thread
+#include <vector>  // for vector
+
+#include <scq/lockfree_slotted_cart_queue.hpp> // for lockfree_slotted_cart_queue
+#include <scq/slotted_cart_queue.hpp>          // for slotted_cart_queue, slot_id
+
+static constexpr size_t slot_count{256};
+static constexpr size_t cart_count{1024};
+static constexpr size_t cart_capacity{64};
+static constexpr size_t consumer_count{4};
+static constexpr size_t elements_per_producer{1u << 16};
+
+// Each producer (state.range(0)) enqueues elements_per_producer elements into random slots out of the first
+// state.range(1) slots; the consumers only drain the queue. Both queues run the same fifo workload.
+template <typename queue_t>
+static void throughput(benchmark::State & state)
+{
+    using value_type = typename queue_t::value_type;
+
+    size_t const producer_count = state.range(0);
+    size_t const used_slot_count = state.range(1);
+
+    std::vector<std::vector<size_t>> producer_slots(producer_count);
+    for (size_t producer_id = 0; producer_id < producer_count; ++producer_id)
+    {
+        std::mt19937_64 engine{producer_id};
+        std::uniform_int_distribution<size_t> distribution{0u, used_slot_count - 1u};
+
+        producer_slots[producer_id].resize(elements_per_producer);
+        for (size_t & slot : producer_slots[producer_id])
+            slot = distribution(engine);
+    }
+
+    for (auto _ : state)
+    {
+        queue_t queue{
+            {.slots = slot_count, .carts = cart_count, .capacity = cart_capacity, .cart_order = scq::cart_order::fifo}};
+
+        std::vector<std::thread> dequeue_threads{};
+        for (size_t consumer_id = 0; consumer_id < consumer_count; ++consumer_id)
+        {
+            dequeue_threads.emplace_back(
+                [&queue]
+                {
+                    while (true)
+                    {
+                        typename queue_t::cart_future_type cart = queue.dequeue();
+
+                        if (!cart.valid())
+                            break;
+
+                        benchmark::DoNotOptimize(cart.get().second.data());
+                    }
+                });
+        }
+
+        std::vector<std::thread> enqueue_threads{};
+        for (size_t producer_id = 0; producer_id < producer_count; ++producer_id)
+        {
+            enqueue_threads.emplace_back(
+                [&queue, &slots = producer_slots[producer_id]]
+                {
+                    for (size_t i = 0; i < slots.size(); ++i)
+                        queue.enqueue(scq::slot_id{slots[i]}, static_cast<value_type>(i));
+                });
+        }
+
+        for (auto && enqueue_thread : enqueue_threads)
+            enqueue_thread.join();
+
+        queue.close();
+
+        for (auto && dequeue_thread : dequeue_threads)
+            dequeue_thread.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * producer_count * elements_per_producer);
+}
+
+// The second argument is the number of used slots; a single used slot lets all producers contend on the same cart.
+BENCHMARK_TEMPLATE(throughput, scq::slotted_cart_queue<uint64_t>)
+    ->ArgsProduct({{1, 2, 4, 8, 16, 32}, {slot_count, 1}})
+    ->ArgNames({"producers", "used_slots"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(throughput, scq::lockfree_slotted_cart_queue<uint64_t>)
+    ->ArgsProduct({{1, 2, 4, 8, 16, 32}, {slot_count, 1}})
+    ->ArgNames({"producers", "used_slots"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
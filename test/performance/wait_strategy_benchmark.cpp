@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <benchmark/benchmark.h> // for State, BENCHMARK_CAPTURE, Counter
+
+#include <sys/resource.h> // for getrusage, rusage, RUSAGE_SELF
+
+#include <algorithm> // for ranges::sort
+#include <chrono>    // for steady_clock, duration_cast, nanoseconds, microseconds
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+#include <thread>    // for thread, this_thread::sleep_for
+#include <vector>    // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slotted_cart_queue, slot_id, wait_strategy
+
+static constexpr size_t slot_count{16};
+static constexpr size_t cart_count{64};
+static constexpr size_t published_cart_count{2000};
+
+static uint64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// CPU time of all threads of the process in microseconds.
+static double process_cpu_time()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e6 + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+// A single producer publishes one cart (of capacity 1) at a time, such that the consumer waits for every cart. The
+// element is the time it was enqueued at; the latency is the time until the consumer dequeued the cart. The CPU time
+// is the time all threads of the process spent on the CPU, i.e. includes the spinning of the waiting consumer.
+static void wait_strategy_latency(benchmark::State & state, scq::wait_strategy wait_strategy)
+{
+    using value_type = uint64_t;
+
+    std::vector<uint64_t> latencies{};
+    double cpu_time{};
+
+    for (auto _ : state)
+    {
+        scq::slotted_cart_queue<value_type> queue{
+            {.slots = slot_count, .carts = cart_count, .capacity = 1, .wait_strategy = wait_strategy}};
+
+        double const cpu_time_before = process_cpu_time();
+
+        std::thread dequeue_thread{[&queue, &latencies]
+                                   {
+                                       while (true)
+                                       {
+                                           scq::cart_future<value_type> cart = queue.dequeue();
+
+                                           if (!cart.valid())
+                                               break;
+
+                                           latencies.push_back(now() - cart.get().second[0]);
+                                       }
+                                   }};
+
+        for (size_t i = 0; i < published_cart_count; ++i)
+        {
+            queue.enqueue(scq::slot_id{i % slot_count}, now());
+
+            // the consumer waits for the next cart
+            std::this_thread::sleep_for(std::chrono::microseconds{50});
+        }
+
+        queue.close();
+        dequeue_thread.join();
+
+        cpu_time += process_cpu_time() - cpu_time_before;
+    }
+
+    std::ranges::sort(latencies);
+    auto percentile = [&latencies](double p)
+    {
+        return latencies.empty() ? 0.0 : static_cast<double>(latencies[(latencies.size() - 1u) * p]) / 1000.0;
+    };
+
+    state.counters["p50_us"] = percentile(0.50);
+    state.counters["p99_us"] = percentile(0.99);
+    state.counters["cpu_us_per_cart"] = cpu_time / static_cast<double>(state.iterations() * published_cart_count);
+    state.SetItemsProcessed(state.iterations() * published_cart_count);
+}
+
+BENCHMARK_CAPTURE(wait_strategy_latency, block, scq::wait_strategy::block)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(wait_strategy_latency, spin, scq::wait_strategy::spin)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(wait_strategy_latency, spin_then_yield, scq::wait_strategy::spin_then_yield)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(wait_strategy_latency, spin_then_block, scq::wait_strategy::spin_then_block)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <benchmark/benchmark.h> // for State, BENCHMARK, DoNotOptimize, Counter
+
+#include <sys/resource.h> // for getrusage, rusage, RUSAGE_SELF
+
+#include <chrono>  // for microseconds
+#include <cstddef> // for size_t
+#include <cstdint> // for uint64_t
+#include <thread>  // for thread, this_thread::sleep_for
+#include <vector>  // for vector
+
+#include <scq/slotted_cart_queue.hpp> // for slotted_cart_queue, slot_id
+
+static constexpr size_t slot_count{64};
+static constexpr size_t cart_count{256};
+static constexpr size_t published_cart_count{2000};
+
+static long context_switches()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+}
+
+// A single producer publishes one cart at a time while state.range(0) consumers are blocked in dequeue. Every cart
+// should wake up a single consumer, i.e. the number of context switches per cart should not grow with the number of
+// consumers.
+static void wakeup_efficiency(benchmark::State & state)
+{
+    using value_type = uint64_t;
+
+    size_t const consumer_count = state.range(0);
+    long switch_count{};
+
+    for (auto _ : state)
+    {
+        scq::slotted_cart_queue<value_type> queue{{.slots = slot_count, .carts = cart_count, .capacity = 1}};
+
+        std::vector<std::thread> dequeue_threads{};
+        for (size_t consumer_id = 0; consumer_id < consumer_count; ++consumer_id)
+        {
+            dequeue_threads.emplace_back(
+                [&queue]
+                {
+                    while (true)
+                    {
+                        scq::cart_future<value_type> cart = queue.dequeue();
+
+                        if (!cart.valid())
+                            break;
+
+                        benchmark::DoNotOptimize(cart.get().second.data());
+                    }
+                });
+        }
+
+        // the consumers are blocked before the first cart is published
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        long const switches_before = context_switches();
+
+        for (size_t i = 0; i < published_cart_count; ++i)
+        {
+            queue.enqueue(scq::slot_id{i % slot_count}, static_cast<value_type>(i));
+
+            // the consumer processed the cart and is blocked again before the next cart is published
+            std::this_thread::sleep_for(std::chrono::microseconds{50});
+        }
+
+        switch_count += context_switches() - switches_before;
+
+        queue.close();
+
+        for (auto && dequeue_thread : dequeue_threads)
+            dequeue_thread.join();
+    }
+
+    state.counters["switches_per_cart"] =
+        static_cast<double>(switch_count) / static_cast<double>(state.iterations() * published_cart_count);
+    state.SetItemsProcessed(state.iterations() * published_cart_count);
+}
+
+BENCHMARK(wakeup_efficiency)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -16,25 +16,30 @@
 
 #include "../atomic_count.hpp"              // for atomic_count
 #include "../concurrent_cross_off_list.hpp" // for concurrent_cross_off_list
+#include "../slotted_cart_queue_types.hpp"  // for slotted_cart_queue_types, slotted_cart_queue_type_names, cart_futu...
 
 static constexpr std::chrono::milliseconds wait_time(10);
 
-TEST(single_item_cart_close_queue, no_producer_no_consumer_close_is_non_blocking)
-{
-    using value_type = int;
+template <typename queue_t>
+class single_item_cart_close_queue : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(single_item_cart_close_queue, slotted_cart_queue_types<int>, slotted_cart_queue_type_names);
 
+TYPED_TEST(single_item_cart_close_queue, no_producer_no_consumer_close_is_non_blocking)
+{
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     queue.close();
 }
 
-TEST(single_item_cart_close_queue, single_producer_no_consumer_enqueue_after_close)
+TYPED_TEST(single_item_cart_close_queue, single_producer_no_consumer_enqueue_after_close)
 {
     using value_type = int;
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     queue.enqueue(scq::slot_id{1}, value_type{100});
     queue.enqueue(scq::slot_id{1}, value_type{101});
@@ -46,12 +51,12 @@ TEST(single_item_cart_close_queue, single_producer_no_consumer_enqueue_after_clo
     EXPECT_THROW(queue.enqueue(scq::slot_id{2}, value_type{200}), std::overflow_error);
 }
 
-TEST(single_item_cart_close_queue, single_producer_no_consumer_release_blocking_enqueue_when_close)
+TYPED_TEST(single_item_cart_close_queue, single_producer_no_consumer_release_blocking_enqueue_when_close)
 {
     using value_type = int;
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     // count number of enqueues
     atomic_count enqueue_count{};
@@ -91,12 +96,12 @@ TEST(single_item_cart_close_queue, single_producer_no_consumer_release_blocking_
     EXPECT_EQ(enqueue_count.load(), 6);
 }
 
-TEST(single_item_cart_close_queue, multiple_producer_no_consumer_enqueue_after_close)
+TYPED_TEST(single_item_cart_close_queue, multiple_producer_no_consumer_enqueue_after_close)
 {
     using value_type = int;
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     // count number of enqueues
     atomic_count enqueue_count{};
@@ -151,38 +156,34 @@ TEST(single_item_cart_close_queue, multiple_producer_no_consumer_enqueue_after_c
         enqueue_thread.join();
 }
 
-TEST(single_item_cart_close_queue, no_producer_single_consumer_dequeue_after_close)
+TYPED_TEST(single_item_cart_close_queue, no_producer_single_consumer_dequeue_after_close)
 {
-    using value_type = int;
-
     // close first then dequeue.
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     queue.close();
 
     // should be non-blocking if queue was closed (without close it would be blocking)
-    scq::cart_future<value_type> cart = queue.dequeue();
+    cart_future_t<TypeParam> cart = queue.dequeue();
 
     EXPECT_FALSE(cart.valid());
 
     EXPECT_THROW(cart.get(), std::future_error);
 }
 
-TEST(single_item_cart_close_queue, no_producer_single_consumer_release_blocking_dequeue_when_close)
+TYPED_TEST(single_item_cart_close_queue, no_producer_single_consumer_release_blocking_dequeue_when_close)
 {
-    using value_type = int;
-
     // dequeue first then close.
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     std::thread dequeue_thread{[&queue]
                                {
                                    // should be blocking if queue was not yet closed
-                                   scq::cart_future<value_type> cart = queue.dequeue();
+                                   cart_future_t<TypeParam> cart = queue.dequeue();
 
                                    EXPECT_FALSE(cart.valid());
 
@@ -198,21 +199,19 @@ TEST(single_item_cart_close_queue, no_producer_single_consumer_release_blocking_
     dequeue_thread.join();
 }
 
-TEST(single_item_cart_close_queue, no_producer_multiple_consumer_dequeue_after_close)
+TYPED_TEST(single_item_cart_close_queue, no_producer_multiple_consumer_dequeue_after_close)
 {
-    using value_type = int;
-
     // close first then dequeue.
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     queue.close();
 
     for (int i = 0; i < 5; ++i) // TODO: this isn't really multiple consumer.
     {
         // should be non-blocking if queue was closed
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
 
         EXPECT_FALSE(cart.valid());
 
@@ -220,14 +219,12 @@ TEST(single_item_cart_close_queue, no_producer_multiple_consumer_dequeue_after_c
     }
 }
 
-TEST(single_item_cart_close_queue, no_producer_multiple_consumer_release_blocking_dequeue_when_close)
+TYPED_TEST(single_item_cart_close_queue, no_producer_multiple_consumer_release_blocking_dequeue_when_close)
 {
-    using value_type = int;
-
     // dequeue first then close.
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     // initialise 5 consuming threads
     std::vector<std::thread> dequeue_threads(5);
@@ -239,7 +236,7 @@ TEST(single_item_cart_close_queue, no_producer_multiple_consumer_release_blockin
                           [&queue]
                           {
                               // should be blocking if queue was not yet closed
-                              scq::cart_future<value_type> cart = queue.dequeue();
+                              cart_future_t<TypeParam> cart = queue.dequeue();
 
                               EXPECT_FALSE(cart.valid());
 
@@ -257,12 +254,12 @@ TEST(single_item_cart_close_queue, no_producer_multiple_consumer_release_blockin
         dequeue_thread.join();
 }
 
-TEST(single_item_cart_close_queue, single_producer_single_consumer_dequeue_after_close)
+TYPED_TEST(single_item_cart_close_queue, single_producer_single_consumer_dequeue_after_close)
 {
     using value_type = int;
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -283,7 +280,7 @@ TEST(single_item_cart_close_queue, single_producer_single_consumer_dequeue_after
     for (int i = 0; i < 5; ++i)
     {
         // close allows to dequeue remaining elements
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -296,14 +293,14 @@ TEST(single_item_cart_close_queue, single_producer_single_consumer_dequeue_after
 
 // TODO: add blocking enqueue test
 // TODO: add maybe blocking enqueue / dequeue test
-TEST(single_item_cart_close_queue, multiple_producer_multiple_consumer_release_blocking_dequeue_when_close)
+TYPED_TEST(single_item_cart_close_queue, multiple_producer_multiple_consumer_release_blocking_dequeue_when_close)
 {
     // this tests whether a blocking dequeue (= queue is empty) will be released by a close.
 
     using value_type = int;
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     // count number of enqueues
     atomic_count enqueue_count{};
@@ -368,7 +365,7 @@ TEST(single_item_cart_close_queue, multiple_producer_multiple_consumer_release_b
                               while (true)
                               {
                                   // should be blocking if queue was not yet closed
-                                  scq::cart_future<value_type> cart = queue.dequeue();
+                                  cart_future_t<TypeParam> cart = queue.dequeue();
 
                                   // abort if queue was closed
                                   if (!cart.valid())
@@ -15,15 +15,22 @@
 #include <scq/slotted_cart_queue.hpp> // for slotted_cart_queue, cart_future, slot_id, future_error, span
 
 #include "../concurrent_cross_off_list.hpp" // for concurrent_cross_off_list
+#include "../slotted_cart_queue_types.hpp"  // for slotted_cart_queue_types, slotted_cart_queue_type_names, cart_futu...
 
 static constexpr size_t max_iterations = 50000;
 
-TEST(single_item_cart_concurrent_integration, multiple_producer_multiple_consumer)
+template <typename queue_t>
+class single_item_cart_concurrent_integration : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(single_item_cart_concurrent_integration, slotted_cart_queue_types<int>, slotted_cart_queue_type_names);
+
+TYPED_TEST(single_item_cart_concurrent_integration, multiple_producer_multiple_consumer)
 {
     using value_type = int;
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -63,7 +70,7 @@ TEST(single_item_cart_concurrent_integration, multiple_producer_multiple_consume
 
                               while (true)
                               {
-                                  scq::cart_future<value_type> cart = queue.dequeue(); // might block
+                                  cart_future_t<TypeParam> cart = queue.dequeue(); // might block
 
                                   if (!cart.valid())
                                   {
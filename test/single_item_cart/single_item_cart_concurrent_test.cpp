@@ -16,15 +16,22 @@
 #include <scq/slotted_cart_queue.hpp> // for slotted_cart_queue, slot_id, cart_future, span, cart_capacity
 
 #include "../concurrent_cross_off_list.hpp" // for concurrent_cross_off_list
+#include "../slotted_cart_queue_types.hpp"  // for slotted_cart_queue_types, slotted_cart_queue_type_names, cart_futu...
 
 static constexpr std::chrono::milliseconds wait_time(10);
 
-TEST(single_item_cart_concurrent, single_producer_single_consumer)
+template <typename queue_t>
+class single_item_cart_concurrent : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(single_item_cart_concurrent, slotted_cart_queue_types<int>, slotted_cart_queue_type_names);
+
+TYPED_TEST(single_item_cart_concurrent, single_producer_single_consumer)
 {
     using value_type = int;
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -50,7 +57,7 @@ TEST(single_item_cart_concurrent, single_producer_single_consumer)
 
     for (int i = 0; i < 5; ++i)
     {
-        scq::cart_future<value_type> cart = queue.dequeue(); // might block
+        cart_future_t<TypeParam> cart = queue.dequeue(); // might block
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -63,12 +70,12 @@ TEST(single_item_cart_concurrent, single_producer_single_consumer)
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(single_item_cart_concurrent, single_producer_multiple_consumer)
+TYPED_TEST(single_item_cart_concurrent, single_producer_multiple_consumer)
 {
     using value_type = int;
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -101,7 +108,7 @@ TEST(single_item_cart_concurrent, single_producer_multiple_consumer)
                       return std::thread(
                           [&queue, &expected]
                           {
-                              scq::cart_future<value_type> cart = queue.dequeue(); // might block
+                              cart_future_t<TypeParam> cart = queue.dequeue(); // might block
                               EXPECT_TRUE(cart.valid());
                               std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -119,12 +126,12 @@ TEST(single_item_cart_concurrent, single_producer_multiple_consumer)
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(single_item_cart_concurrent, multiple_producer_single_consumer)
+TYPED_TEST(single_item_cart_concurrent, multiple_producer_single_consumer)
 {
     using value_type = int;
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -170,7 +177,7 @@ TEST(single_item_cart_concurrent, multiple_producer_single_consumer)
 
     for (int i = 0; i < 5; ++i)
     {
-        scq::cart_future<value_type> cart = queue.dequeue(); // might block
+        cart_future_t<TypeParam> cart = queue.dequeue(); // might block
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -184,12 +191,12 @@ TEST(single_item_cart_concurrent, multiple_producer_single_consumer)
     EXPECT_TRUE(expected.empty());
 }
 
-TEST(single_item_cart_concurrent, multiple_producer_multiple_consumer)
+TYPED_TEST(single_item_cart_concurrent, multiple_producer_multiple_consumer)
 {
     using value_type = int;
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -242,7 +249,7 @@ TEST(single_item_cart_concurrent, multiple_producer_multiple_consumer)
                       return std::thread(
                           [&queue, &expected]
                           {
-                              scq::cart_future<value_type> cart = queue.dequeue(); // might block
+                              cart_future_t<TypeParam> cart = queue.dequeue(); // might block
                               EXPECT_TRUE(cart.valid());
                               std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -11,19 +11,26 @@
 #include <scq/slotted_cart_queue.hpp> // for slot_id, slotted_cart_queue, span, cart_future, cart_capacity
 
 #include "../concurrent_cross_off_list.hpp" // for concurrent_cross_off_list
+#include "../slotted_cart_queue_types.hpp"  // for slotted_cart_queue_types, slotted_cart_queue_type_names, cart_futu...
 
-TEST(single_item_cart_sequential, single_enqueue_dequeue)
+template <typename queue_t>
+class single_item_cart_sequential : public ::testing::Test
+{};
+
+TYPED_TEST_SUITE(single_item_cart_sequential, slotted_cart_queue_types<int>, slotted_cart_queue_type_names);
+
+TYPED_TEST(single_item_cart_sequential, single_enqueue_dequeue)
 {
     using value_type = int;
 
     // this slotted_cart_queue should behave like a normal queue
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     queue.enqueue(scq::slot_id{1}, value_type{100});
 
     // item enqueued will be available immediately. (cart can contain only one item)
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -35,7 +42,7 @@ TEST(single_item_cart_sequential, single_enqueue_dequeue)
 
     // item enqueued will be available immediately. (cart can contain only one item)
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -44,12 +51,12 @@ TEST(single_item_cart_sequential, single_enqueue_dequeue)
     }
 }
 
-TEST(single_item_cart_sequential, multiple_enqueue_dequeue)
+TYPED_TEST(single_item_cart_sequential, multiple_enqueue_dequeue)
 {
     using value_type = int;
 
     // this slotted_cart_queue should behave like a normal queue, but with nondeterministic results
-    scq::slotted_cart_queue<value_type> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    TypeParam queue{{.slots = 5, .carts = 5, .capacity = 1}};
 
     // expected set contains all (expected) results; after the test which set should be empty (each matching result will
     // be crossed out)
@@ -67,7 +74,7 @@ TEST(single_item_cart_sequential, multiple_enqueue_dequeue)
 
     for (int i = 0; i < 5; ++i)
     {
-        scq::cart_future<value_type> cart = queue.dequeue();
+        cart_future_t<TypeParam> cart = queue.dequeue();
         EXPECT_TRUE(cart.valid());
         std::pair<scq::slot_id, std::span<value_type>> cart_data = cart.get();
 
@@ -4,9 +4,13 @@
 
 #include <gtest/gtest.h> // for Test, TestInfo, Message, TEST, EXPECT_THROW, TestPartResult
 
-#include <string> // for basic_string
+#include <cstddef> // for size_t
+#include <string>  // for basic_string
+#include <thread>  // for thread
+#include <vector>  // for vector
 
-#include <scq/slotted_cart_queue.hpp> // for slotted_cart_queue, logic_error, cart_capacity, cart_count, slot_count
+#include <scq/lockfree_slotted_cart_queue.hpp> // for lockfree_slotted_cart_queue
+#include <scq/slotted_cart_queue.hpp>          // for slotted_cart_queue, logic_error, cart_capacity, cart_count, slo...
 
 TEST(slotted_cart_queue_test, default_construct)
 {
@@ -16,6 +20,9 @@ TEST(slotted_cart_queue_test, default_construct)
 TEST(slotted_cart_queue_test, valid_construct)
 {
     scq::slotted_cart_queue<int> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+    scq::slotted_cart_queue<int> striped_queue{{.slots = 5, .carts = 5, .capacity = 1, .lock_stripes = 2}};
+    scq::slotted_cart_queue<int> fifo_queue{
+        {.slots = 5, .carts = 5, .capacity = 1, .cart_order = scq::cart_order::fifo}};
 }
 
 TEST(slotted_cart_queue_test, invalid_construct)
@@ -26,3 +33,75 @@ TEST(slotted_cart_queue_test, invalid_construct)
     // less carts than slots (would dead-lock)
     EXPECT_THROW((scq::slotted_cart_queue<int>{{.slots = 5, .carts = 1, .capacity = 1}}), std::logic_error);
 }
+
+TEST(slotted_cart_queue_test, lockfree_construct)
+{
+    scq::lockfree_slotted_cart_queue<int> default_queue{};
+    scq::lockfree_slotted_cart_queue<int> queue{{.slots = 5, .carts = 5, .capacity = 1}};
+
+    EXPECT_THROW((scq::lockfree_slotted_cart_queue<int>{{.slots = 5, .carts = 5, .capacity = 0}}), std::logic_error);
+    EXPECT_THROW((scq::lockfree_slotted_cart_queue<int>{{.slots = 5, .carts = 1, .capacity = 1}}), std::logic_error);
+
+    // neither partitions nor exclusive slots are supported
+    EXPECT_THROW((scq::lockfree_slotted_cart_queue<int>{{.slots = 4, .carts = 4, .capacity = 1, .partitions = 2}}),
+                 std::logic_error);
+    EXPECT_THROW(
+        (scq::lockfree_slotted_cart_queue<int>{{.slots = 4, .carts = 4, .capacity = 1, .exclusive_slots = true}}),
+        std::logic_error);
+}
+
+TEST(slotted_cart_queue_test, shared_lock_stripes)
+{
+    using value_type = int;
+
+    static constexpr size_t slot_count{5};
+    static constexpr size_t value_count{1000};
+
+    // slots 0, 2, 4 and slots 1, 3 share a lock
+    scq::slotted_cart_queue<value_type> queue{{.slots = slot_count, .carts = 7, .capacity = 3, .lock_stripes = 2}};
+
+    std::vector<std::thread> enqueue_threads{};
+    for (size_t thread_id = 0; thread_id < slot_count; ++thread_id)
+    {
+        enqueue_threads.emplace_back(
+            [thread_id, &queue]
+            {
+                for (size_t i = 0; i < value_count; ++i)
+                    queue.enqueue(scq::slot_id{thread_id}, static_cast<value_type>(i));
+            });
+    }
+
+    std::vector<size_t> value_sums(slot_count);
+    std::vector<size_t> value_counts(slot_count);
+
+    std::thread dequeue_thread{[&]
+                               {
+                                   while (true)
+                                   {
+                                       scq::cart_future<value_type> cart = queue.dequeue();
+
+                                       if (!cart.valid())
+                                           break;
+
+                                       auto [slot, values] = cart.get();
+                                       for (value_type value : values)
+                                       {
+                                           value_sums[slot.value] += value;
+                                           ++value_counts[slot.value];
+                                       }
+                                   }
+                               }};
+
+    for (auto && enqueue_thread : enqueue_threads)
+        enqueue_thread.join();
+
+    queue.close();
+
+    dequeue_thread.join();
+
+    for (size_t slot = 0; slot < slot_count; ++slot)
+    {
+        EXPECT_EQ(value_counts[slot], value_count);
+        EXPECT_EQ(value_sums[slot], value_count * (value_count - 1) / 2);
+    }
+}
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2006-2025 Knut Reinert & Freie Universität Berlin
+// SPDX-FileCopyrightText: 2016-2025 Knut Reinert & MPI für molekulare Genetik
+// SPDX-License-Identifier: BSD-3-Clause
+
+#pragma once
+
+#include <gtest/gtest.h> // for Types
+
+#include <concepts> // for same_as
+#include <string>   // for string
+
+#include <scq/lockfree_slotted_cart_queue.hpp> // for lockfree_slotted_cart_queue
+#include <scq/slotted_cart_queue.hpp>          // for slotted_cart_queue
+
+// The queues that provide enqueue, dequeue and close; the tests of these operations are typed tests over all of them.
+template <typename value_t>
+using slotted_cart_queue_types =
+    ::testing::Types<scq::slotted_cart_queue<value_t>, scq::lockfree_slotted_cart_queue<value_t>>;
+
+struct slotted_cart_queue_type_names
+{
+    template <typename queue_t>
+    static std::string GetName(int)
+    {
+        if constexpr (std::same_as<queue_t, scq::lockfree_slotted_cart_queue<typename queue_t::value_type>>)
+            return "lockfree_slotted_cart_queue";
+        else
+            return "slotted_cart_queue";
+    }
+};
+
+template <typename queue_t>
+using cart_future_t = typename queue_t::cart_future_type;